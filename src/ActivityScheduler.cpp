@@ -26,20 +26,66 @@
 #include <vle/utils/Trace.hpp>
 
 #include <data/Activity.hpp>
+#include <data/ActivityStore.hpp>
+#include <data/CriticalPath.hpp>
 #include <data/PrecedencesGraph.hpp>
+#include <data/ReleaseCalendar.hpp>
+#include <data/Run.hpp>
 
 #include <iostream>
 
 namespace rcpsp {
 
+    /**
+     * Releases the activities when their window opens and their
+     * predecessors allow it. An activity is taken as started when it is
+     * sent to its location: the successors of its SS and SF constraints
+     * are released from that date, before its first step starts on a
+     * processor, so their lags are counted from the dispatch.
+     */
     class ActivityScheduler : public vle::devs::Dynamics
     {
     public:
         ActivityScheduler(const vle::devs::DynamicsInit& init,
                           const vle::devs::InitEventList& events) :
-            vle::devs::Dynamics(init, events),
-            mActivities(events.get("activities"))
+            vle::devs::Dynamics(init, events), mStore(0)
         {
+            Activities activities(events.get("activities"));
+
+            if (events.exist("precedences")) {
+                mPrecedencesGraph = PrecedencesGraph(
+                    events.get("precedences"), activities);
+                mPrecedencesGraph.rank(activities);
+                CriticalPath::configure(events, mPrecedencesGraph,
+                                        activities);
+            }
+            if (events.exist("store") and
+                vle::value::toBoolean(events.get("store"))) {
+                mStore = new ActivityStore(activities);
+            }
+
+            // the calendar and the activities waiting for their
+            // predecessors take the ownership of the activities
+            mBlockedActivities.assign(activities.size(), 0);
+            for (unsigned int i = 0; i < activities.size(); ++i) {
+                if (mPrecedencesGraph.empty() or
+                    mPrecedencesGraph.ready(i)) {
+                    mCalendar.push(activities[i]);
+                } else {
+                    mBlockedActivities[i] = activities[i];
+                }
+                activities[i] = 0;
+            }
+        }
+
+        virtual ~ActivityScheduler()
+        {
+            for (std::vector < Activity* >::iterator it =
+                     mBlockedActivities.begin();
+                 it != mBlockedActivities.end(); ++it) {
+                delete *it;
+            }
+            delete mStore;
         }
 
         vle::devs::Time init(const vle::devs::Time& time)
@@ -55,7 +101,7 @@ namespace rcpsp {
         {
             if (mPhase == SEND) {
                 const Activities::result_t& activities =
-                    mActivities.startingActivities();
+                    mCalendar.startingActivities();
 
                 for(Activities::result_t::const_iterator it =
                         activities.begin();
@@ -65,7 +111,8 @@ namespace rcpsp {
 
                     ee << vle::devs::attribute("location",
                                                (*it)->location().name());
-                    ee << vle::devs::attribute("activity", (*it)->toValue());
+                    ee << vle::devs::attribute("activity",
+                                               (*it)->toEventValue());
                     output.push_back(ee);
                 }
             }
@@ -86,23 +133,30 @@ namespace rcpsp {
         {
             if (mPhase == SEND) {
                 const Activities::result_t& activities =
-                    mActivities.startingActivities();
+                    mCalendar.startingActivities();
+                const Activities::result_t& late =
+                    mCalendar.lateActivities();
+                PrecedencesGraph::result_t ready;
 
+                for(Activities::result_t::const_iterator it = late.begin();
+                    it != late.end(); ++it) {
+                    TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% LATE") %
+                               getModel().getParentName() % getModelName() %
+                               time % (*it)->name());
+
+                    mLateActivities.push_back((*it)->name());
+                }
                 for(Activities::result_t::const_iterator it =
                         activities.begin();
                     it != activities.end(); ++it) {
                     mRunningActivities.push_back(*it);
+                    mPrecedencesGraph.started((*it)->handle(), time, ready);
                 }
-                mActivities.removeStartingActivities();
-                if (mActivities.empty()) {
-                    mPhase = DONE;
-                } else {
-                    mSigma = mActivities.next(time);
-                    mLastTime = time;
-                    mPhase = WAIT;
-                }
+                mCalendar.removeStartingActivities();
+                release(ready);
+                wait(time);
             } else if (mPhase == WAIT) {
-                mActivities.starting(time);
+                mCalendar.starting(time);
                 mPhase = SEND;
             }
         }
@@ -112,12 +166,13 @@ namespace rcpsp {
             const vle::devs::Time& time)
         {
             vle::devs::ExternalEventList::const_iterator it = events.begin();
+            PrecedencesGraph::result_t ready;
 
             while (it != events.end()) {
                 if ((*it)->onPort("start")) {
                     if (mPhase == INIT) {
-                        mActivities.starting(time);
-                        if (mActivities.startingActivities().empty()) {
+                        mCalendar.starting(time);
+                        if (mCalendar.startingActivities().empty()) {
                             mPhase = WAIT;
                         } else {
                             mPhase = SEND;
@@ -130,10 +185,18 @@ namespace rcpsp {
                                getModel().getParentName() % getModelName() %
                                time % a->name());
 
+                    mPrecedencesGraph.finished(a->handle(), time, ready);
                     mDoneActivities.push_back(a);
                 }
                 ++it;
             }
+            if (not ready.empty()) {
+                release(ready);
+                if (mPhase == WAIT or mPhase == DONE) {
+                    wait(time);
+                    return;
+                }
+            }
             if (mSigma > 0) {
                 mSigma -= (time - mLastTime);
                 mLastTime = time;
@@ -149,17 +212,62 @@ namespace rcpsp {
                        time);
         }
 
+        vle::value::Value* observation(
+            const vle::devs::ObservationEvent& event) const
+        {
+            if (event.onPort("late")) {
+                vle::value::Set* value = new vle::value::Set;
+
+                for (std::vector < std::string >::const_iterator it =
+                         mLateActivities.begin();
+                     it != mLateActivities.end(); ++it) {
+                    value->add(new vle::value::String(*it));
+                }
+                return value;
+            }
+            return 0;
+        }
+
     private:
         enum Phase { DONE, INIT, WAIT, SEND };
 
+        /** Hand the activities whose predecessors are satisfied over to the
+            calendar, after the time lag of their constraints. */
+        void release(const PrecedencesGraph::result_t& ready)
+        {
+            for (PrecedencesGraph::result_t::const_iterator it = ready.begin();
+                 it != ready.end(); ++it) {
+                Activity* a = mBlockedActivities[*it];
+
+                mBlockedActivities[*it] = 0;
+                mCalendar.push(a, mPrecedencesGraph.release(*it));
+            }
+        }
+
+        void wait(const vle::devs::Time& time)
+        {
+            if (mCalendar.empty()) {
+                mPhase = DONE;
+            } else {
+                mSigma = mCalendar.next(time);
+                mLastTime = time;
+                mPhase = WAIT;
+            }
+        }
+
+        Run mRun;
         Phase mPhase;
         vle::devs::Time mLastTime;
         vle::devs::Time mSigma;
 
-        Activities mActivities;
+        ReleaseCalendar mCalendar;
         Activities mRunningActivities;
         Activities mDoneActivities;
         PrecedencesGraph mPrecedencesGraph;
+        std::vector < Activity* > mBlockedActivities;
+        // the activities started after the close of their window
+        std::vector < std::string > mLateActivities;
+        ActivityStore* mStore;
     };
 
 } // namespace rcpsp
@@ -27,105 +27,111 @@
 
 #include <data/Resources.hpp>
 #include <data/ResourceConstraints.hpp>
+#include <data/Run.hpp>
+
+#include <map>
 
 namespace rcpsp {
 
+    /**
+     * The negotiation of the resources of a location with its PoolBank
+     * model. Each demand of a step is tagged and sent whole to the bank,
+     * which answers once with its tag: the resources are assigned to the
+     * requester given with the demand, or the missing quantity of each
+     * type is sent on the "unavailable" port. Several demands are
+     * negotiated at the same time.
+     *
+     * The number of resources of each type released by the bank is sent
+     * on the "released" port, so the schedulers know when a demand may
+     * succeed.
+     */
     class Assignment : public vle::devs::Dynamics
     {
     public:
         Assignment(const vle::devs::DynamicsInit& init,
                    const vle::devs::InitEventList& events) :
-            vle::devs::Dynamics(init, events)
+            vle::devs::Dynamics(init, events), mTag(0)
+        {
+        }
+
+        virtual ~Assignment()
         {
+            clearDemands();
         }
 
         vle::devs::Time init(const vle::devs::Time& /* time */)
         {
-            mResourceConstraints = 0;
-            mAvailableResourceNumber = 0;
-            mReleasedResources = 0;
-            mResponseNumber = 0;
-            mPhase = WAIT_DEMAND;
             return vle::devs::infinity;
         }
 
-        void output(const vle::devs::Time& time,
+        void output(const vle::devs::Time& /* time */,
                     vle::devs::ExternalEventList& output) const
         {
-            if (mPhase == SEND_ASSIGN) {
-                for (ResourceConstraints::const_iterator it =
-                         mResourceConstraints->begin();
-                     it != mResourceConstraints->end(); ++it) {
-                    vle::devs::ExternalEvent* ee =
-                        new vle::devs::ExternalEvent("assign");
-
-                    ee << vle::devs::attribute("type", it->type());
-                    ee << vle::devs::attribute("quantity", (int)it->quantity());
-                    output.push_back(ee);
-                }
-            } else if (mPhase == SEND_DEMAND) {
-                for (ResourceConstraints::const_iterator it =
-                         mResourceConstraints->begin();
-                     it != mResourceConstraints->end(); ++it) {
-                    vle::devs::ExternalEvent* ee =
-                        new vle::devs::ExternalEvent("demand");
-
-                    TraceModel(
-                        vle::fmt(" [%1%:%2%] at %3% -> demand: %4% = %5%") %
-                        getModel().getParentName() % getModelName() %
-                        time % it->type() % it->quantity());
-
-                    ee << vle::devs::attribute("type", it->type());
-                    ee << vle::devs::attribute("quantity", (int)it->quantity());
-                    output.push_back(ee);
-                }
-            } else if (mPhase == SEND_RELEASE) {
+            for (demands_t::const_iterator it = mDemands.begin();
+                 it != mDemands.end(); ++it) {
                 vle::devs::ExternalEvent* ee =
-                    new vle::devs::ExternalEvent("release");
+                    new vle::devs::ExternalEvent("demand");
+
+                ee << vle::devs::attribute("resources",
+                                           it->second->toEventValue());
+                ee << vle::devs::attribute("tag", (int)it->first);
+                output.push_back(ee);
+            }
+            for (grants_t::const_iterator it = mGrants.begin();
+                 it != mGrants.end(); ++it) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("assign");
 
+                ee << vle::devs::attribute("requester", it->first);
                 ee << vle::devs::attribute("resources",
-                                           mReleasedResources->toValue());
+                                           it->second.toEventValue());
                 output.push_back(ee);
-            } else if (mPhase == SEND_UNAVAILABLE) {
+            }
+            for (unavailables_t::const_iterator it = mUnavailables.begin();
+                 it != mUnavailables.end(); ++it) {
                 vle::devs::ExternalEvent* ee =
                     new vle::devs::ExternalEvent("unavailable");
 
+                ee << vle::devs::attribute("requester", it->first);
+                ee << vle::devs::attribute("resources", it->second.toValue());
+                output.push_back(ee);
+            }
+            if (not mReleasedResources.empty()) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("release");
+
                 ee << vle::devs::attribute("resources",
-                                           mUnavailableResources.toValue());
+                                           mReleasedResources.toEventValue());
+                output.push_back(ee);
+            }
+            if (not mReleasedTypes.empty()) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("released");
+
+                ee << vle::devs::attribute("resources",
+                                           mReleasedTypes.toValue());
                 output.push_back(ee);
             }
         }
 
         vle::devs::Time timeAdvance() const
         {
-            if (mPhase == SEND_ASSIGN or mPhase == SEND_DEMAND or
-                mPhase == SEND_RELEASE or mPhase == SEND_UNAVAILABLE) {
-                return 0;
-            } else {
+            if (mDemands.empty() and mGrants.empty() and
+                mUnavailables.empty() and mReleasedResources.empty() and
+                mReleasedTypes.empty()) {
                 return vle::devs::infinity;
+            } else {
+                return 0;
             }
         }
 
         void internalTransition(const vle::devs::Time& /* time */)
         {
-            if (mPhase == SEND_ASSIGN) {
-                clearDemand();
-                mPhase = WAIT_DEMAND;
-            } else if (mPhase == SEND_DEMAND) {
-                mPhase = WAIT_AVAILABLE;
-            } else if (mPhase == SEND_RELEASE) {
-                delete mReleasedResources;
-                mReleasedResources = 0;
-                if (mResourceConstraints != 0 and
-                    mResponseNumber < mResourceConstraints->size()) {
-                    mPhase = WAIT_AVAILABLE;
-                } else {
-                    mPhase = WAIT_DEMAND;
-                }
-            } else if (mPhase == SEND_UNAVAILABLE) {
-                mUnavailableResources.clear();
-                mPhase = WAIT_DEMAND;
-            }
+            clearDemands();
+            mGrants.clear();
+            mUnavailables.clear();
+            mReleasedResources.clear();
+            mReleasedTypes.clear();
         }
 
         void externalTransition(
@@ -136,54 +142,46 @@ namespace rcpsp {
 
             while (it != events.end()) {
                 if ((*it)->onPort("available")) {
-                    bool available =
-                        (*it)->getBooleanAttributeValue("available");
-                    unsigned int number =
-                        (*it)->getIntegerAttributeValue("number");
-                    std::string type = (*it)->getStringAttributeValue("type");
-
-                    if (available) {
-                        mAvailableResourceNumber += number;
-                    } else {
-                        mUnavailableResources[type] =
-                            mResourceConstraints->quantity(type) - number;
-                    }
-                    ++mResponseNumber;
-
-                    TraceModel(
-                        vle::fmt(" [%1%:%2%] at %3% -> available: %4% / %5%")
-                        % getModel().getParentName() % getModelName() %
-                        time % mAvailableResourceNumber %
-                        mResourceConstraints->quantity());
-
-                    if (mAvailableResourceNumber ==
-                        mResourceConstraints->quantity()) {
-                        mPhase = SEND_ASSIGN;
-                    } else {
-                        if (mResponseNumber == mResourceConstraints->size()) {
-                            clearDemand();
-                            mPhase = SEND_UNAVAILABLE;
-                        } else {
-                            mPhase = WAIT_AVAILABLE;
-                        }
+                    requesters_t::iterator itr = mRequesters.find(
+                        (*it)->getIntegerAttributeValue("tag"));
+
+                    if (itr != mRequesters.end()) {
+                        answer(itr->second, *it);
+                        mRequesters.erase(itr);
                     }
                 } else if ((*it)->onPort("demand")) {
-                    mResourceConstraints =
-                        ResourceConstraints::build(Resources::get(*it));
+                    ResourceDemand* demand =
+                        ResourceDemand::build(Resources::get(*it));
+                    std::string requester;
+
+                    if ((*it)->existAttributeValue("requester")) {
+                        requester =
+                            (*it)->getStringAttributeValue("requester");
+                    }
 
                     TraceModel(vle::fmt(" [%1%:%2%] at %3% -> demand: %4%") %
                                getModel().getParentName() % getModelName() %
-                               time % mResourceConstraints->quantity());
+                               time % demand->quantity());
 
-                    mPhase = SEND_DEMAND;
+                    mRequesters[mTag] = requester;
+                    mDemands.push_back(std::make_pair(mTag++, demand));
                 } else if ((*it)->onPort("release")) {
-                    mReleasedResources = Resources::build(Resources::get(*it));
+                    Resources r(&Resources::get(*it));
 
                     TraceModel(vle::fmt(" [%1%:%2%] at %3% -> release: %4%") %
                                getModel().getParentName() % getModelName() %
-                               time % *mReleasedResources);
+                               time % r);
+
+                    mReleasedResources.add(r);
+                } else if ((*it)->onPort("released")) {
+                    ResourceTypes released(&ResourceTypes::get(*it));
 
-                    mPhase = SEND_RELEASE;
+                    for (unsigned int type = 0; type < released.size();
+                         ++type) {
+                        if (released[type] > 0) {
+                            mReleasedTypes[type] += released[type];
+                        }
+                    }
                 }
                 ++it;
             }
@@ -191,11 +189,14 @@ namespace rcpsp {
 
         void confluentTransitions(
             const vle::devs::Time& time,
-            const vle::devs::ExternalEventList& /* events */)
+            const vle::devs::ExternalEventList& events)
         {
             TraceModel(vle::fmt(" [%1%:%2%] at %3% -> confluent !") %
                        getModel().getParentName() % getModelName() %
                        time);
+
+            internalTransition(time);
+            externalTransition(events, time);
         }
 
         virtual vle::value::Value* observation(
@@ -205,23 +206,45 @@ namespace rcpsp {
         }
 
     private:
-        void clearDemand()
+        typedef std::vector < std::pair < unsigned int, ResourceDemand* > >
+        demands_t;
+        typedef std::map < unsigned int, std::string > requesters_t;
+        typedef std::vector < std::pair < std::string, Resources > >
+        grants_t;
+        typedef std::vector < std::pair < std::string, ResourceTypes > >
+        unavailables_t;
+
+        /** The answer of the bank to the demand of the requester. */
+        void answer(const std::string& requester,
+                    const vle::devs::ExternalEvent* event)
         {
-            mAvailableResourceNumber = 0;
-            mResponseNumber = 0;
-            delete mResourceConstraints;
-            mResourceConstraints = 0;
+            if (event->getBooleanAttributeValue("available")) {
+                mGrants.push_back(std::make_pair(
+                        requester, Resources(&Resources::get(event))));
+            } else {
+                mUnavailables.push_back(std::make_pair(
+                        requester,
+                        ResourceTypes(&event->getAttributeValue("missing"))));
+            }
         }
 
-        enum Phase { WAIT_AVAILABLE, WAIT_DEMAND, SEND_DEMAND, SEND_ASSIGN,
-                     SEND_RELEASE, SEND_UNAVAILABLE };
+        void clearDemands()
+        {
+            for (demands_t::iterator it = mDemands.begin();
+                 it != mDemands.end(); ++it) {
+                delete it->second;
+            }
+            mDemands.clear();
+        }
 
-        Phase mPhase;
-        ResourceConstraints* mResourceConstraints;
-        unsigned int mResponseNumber;
-        unsigned int mAvailableResourceNumber;
-        Resources* mReleasedResources;
-        ResourceTypes mUnavailableResources;
+        Run mRun;
+        unsigned int mTag;
+        demands_t mDemands;
+        requesters_t mRequesters;
+        grants_t mGrants;
+        unavailables_t mUnavailables;
+        Resources mReleasedResources;
+        ResourceTypes mReleasedTypes;
     };
 
 } // namespace rcpsp
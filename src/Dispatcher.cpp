@@ -24,6 +24,7 @@
 #include <vle/devs/Dynamics.hpp>
 
 #include <data/Location.hpp>
+#include <data/Run.hpp>
 
 namespace rcpsp {
 
@@ -102,6 +103,7 @@ namespace rcpsp {
 
         typedef std::list < vle::devs::ExternalEvent* > events;
 
+        Run mRun;
         phase mPhase;
         events mEvents;
     };
@@ -0,0 +1,45 @@
+/**
+ * @file PolicyStepScheduler.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <devs/StepScheduler.tpp>
+#include <policy/Policies.hpp>
+
+// the policy of the model, set by the build for each shipped policy; a
+// custom policy is declared in the header named by
+// STEP_SCHEDULING_POLICY_HEADER
+#ifdef STEP_SCHEDULING_POLICY_HEADER
+#include STEP_SCHEDULING_POLICY_HEADER
+#endif
+
+#ifndef STEP_SCHEDULING_POLICY
+#define STEP_SCHEDULING_POLICY FIFOPolicy
+#endif
+
+namespace rcpsp {
+
+    typedef devs::StepScheduler < STEP_SCHEDULING_POLICY >
+    PolicyStepScheduler;
+
+} // namespace rcpsp
+
+DECLARE_DYNAMICS(rcpsp::PolicyStepScheduler);
@@ -0,0 +1,194 @@
+/**
+ * @file PoolBank.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <vle/devs/Dynamics.hpp>
+#include <vle/value/Set.hpp>
+
+#include <vle/utils/Trace.hpp>
+
+#include <data/ResourceBank.hpp>
+#include <data/Run.hpp>
+
+namespace rcpsp {
+
+    /**
+     * All the pools of a location in one model. Each demand arrives whole
+     * in one event with its tag and is answered in one event: either all
+     * its resources are taken from the bank and sent, or nothing is taken
+     * and the missing quantity of each type is sent. The pools of the same
+     * type are merged.
+     */
+    class PoolBank : public vle::devs::Dynamics
+    {
+    public:
+        PoolBank(const vle::devs::DynamicsInit& init,
+                 const vle::devs::InitEventList& events) :
+            vle::devs::Dynamics(init, events),
+            mBank(events.get("pools")),
+            mPublish(events.exist("publish") and
+                     vle::value::toBoolean(events.get("publish")))
+        {
+        }
+
+        vle::devs::Time init(const vle::devs::Time& /* time */)
+        {
+            return vle::devs::infinity;
+        }
+
+        void output(const vle::devs::Time& time,
+                    vle::devs::ExternalEventList& output) const
+        {
+            for (answers_t::const_iterator it = mAnswers.begin();
+                 it != mAnswers.end(); ++it) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("available");
+
+                TraceModel(
+                    vle::fmt(" [%1%:%2%] at %3% -> send available: %4%")
+                    % getModel().getParentName() % getModelName() %
+                    time % it->available);
+
+                ee << vle::devs::attribute("available", it->available);
+                ee << vle::devs::attribute("tag", it->tag);
+                if (it->available) {
+                    ee << vle::devs::attribute(
+                        "resources", it->granted.toEventValue());
+                } else {
+                    ee << vle::devs::attribute("missing",
+                                               it->missing.toValue());
+                }
+                output.push_back(ee);
+            }
+            if (not mReleased.empty()) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("released");
+
+                ee << vle::devs::attribute("resources", mReleased.toValue());
+                output.push_back(ee);
+            }
+        }
+
+        vle::devs::Time timeAdvance() const
+        {
+            if (mAnswers.empty() and mReleased.empty()) {
+                return vle::devs::infinity;
+            } else {
+                return 0;
+            }
+        }
+
+        void internalTransition(const vle::devs::Time& /* time */)
+        {
+            mAnswers.clear();
+            mReleased.clear();
+        }
+
+        void externalTransition(
+            const vle::devs::ExternalEventList& events,
+            const vle::devs::Time& time)
+        {
+            vle::devs::ExternalEventList::const_iterator it = events.begin();
+
+            while (it != events.end()) {
+                if ((*it)->onPort("demand")) {
+                    ResourceDemand demand(&Resources::get(*it));
+                    Answer answer;
+
+                    TraceModel(vle::fmt(" [%1%:%2%] at %3% -> demand: %4%") %
+                               getModel().getParentName() % getModelName() %
+                               time % demand.quantity());
+
+                    answer.tag = (*it)->getIntegerAttributeValue("tag");
+                    answer.available = mBank.reserve(demand, answer.granted,
+                                                     answer.missing);
+                    mAnswers.push_back(answer);
+                } else if ((*it)->onPort("release")) {
+                    Resources r(&Resources::get(*it));
+
+                    TraceModel(vle::fmt(" [%1%:%2%] at %3% -> release: %4%")
+                               % getModel().getParentName() % getModelName() %
+                               time % r);
+
+                    mBank.release(r);
+                    if (mPublish) {
+                        for (Resources::const_iterator itr = r.begin();
+                             itr != r.end(); ++itr) {
+                            ++mReleased[Resources::resource(*itr).type()];
+                        }
+                    }
+                }
+                ++it;
+            }
+        }
+
+        void confluentTransitions(
+            const vle::devs::Time& time,
+            const vle::devs::ExternalEventList& events)
+        {
+            TraceModel(vle::fmt(" [%1%:%2%] at %3% -> confluent !") %
+                       getModel().getParentName() % getModelName() %
+                       time);
+
+            internalTransition(time);
+            externalTransition(events, time);
+        }
+
+        virtual vle::value::Value* observation(
+            const vle::devs::ObservationEvent& event) const
+        {
+            if (event.onPort("available_resources")) {
+                vle::value::Set* list = new vle::value::Set;
+
+                for (Resources::const_iterator it = mBank.available().begin();
+                     it != mBank.available().end(); ++it) {
+                    list->add(new vle::value::String(
+                                  Resources::resource(*it).name()));
+                }
+                return list;
+            }
+            return 0;
+        }
+
+    private:
+        /** The answer to the demand of the given tag. */
+        struct Answer
+        {
+            int tag;
+            bool available;
+            Resources granted;
+            ResourceTypes missing;
+        };
+
+        typedef std::vector < Answer > answers_t;
+
+        Run mRun;
+        ResourceBank mBank;
+        bool mPublish;
+        answers_t mAnswers;
+        ResourceTypes mReleased;
+    };
+
+} // namespace rcpsp
+
+DECLARE_DYNAMICS(rcpsp::PoolBank);
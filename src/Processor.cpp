@@ -25,6 +25,8 @@
 
 #include <vle/utils/Trace.hpp>
 
+#include <data/FinishCalendar.hpp>
+
 namespace rcpsp {
 
     class Processor : public devs::Processor
@@ -32,45 +34,24 @@ namespace rcpsp {
     public:
         Processor(const vle::devs::DynamicsInit& init,
                   const vle::devs::InitEventList& events) :
-            devs::Processor(init, events)
+            devs::Processor(init, events), mFinishDates(mRunningActivities)
         { }
 
         vle::devs::Time computeRemainingTime(const vle::devs::Time& time) const
-        {
-            vle::devs::Time min = vle::devs::infinity;
-
-            for(Activities::const_iterator it = mRunningActivities.begin();
-                it != mRunningActivities.end(); ++it) {
-                vle::devs::Time rt = (*it)->remainingTime(time);
-
-                if (rt < min) {
-                    min = rt;
-                }
-            }
-            return min;
-        }
+        { return mFinishDates.next(time); }
 
         virtual void done(const vle::devs::Time& /* time */)
         { mDoneActivities.clear(); }
 
         virtual void finish(const vle::devs::Time& time)
         {
-            Activities::iterator it = mRunningActivities.begin();
-
-            while (it != mRunningActivities.end()) {
-                if ((*it)->done(time)) {
-
-                    TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% finishs") %
-                               getModel().getParentName() % getModelName() %
-                               time % (*it)->name());
-
-                    (*it)->finish(time);
-                    mDoneActivities.push_back(*it);
-                    mRunningActivities.erase(it);
-                    it = mRunningActivities.begin();
-                } else {
-                    ++it;
-                }
+            unsigned int first = mDoneActivities.size();
+
+            mFinishDates.finish(time, mDoneActivities);
+            for (unsigned int i = first; i < mDoneActivities.size(); ++i) {
+                TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% finishs") %
+                           getModel().getParentName() % getModelName() %
+                           time % mDoneActivities[i]->name());
             }
         }
 
@@ -83,10 +64,11 @@ namespace rcpsp {
                        getModel().getParentName() % getModelName() %
                        time % a->name());
 
-            a->start(time);
-            mRunningActivities.push_back(a);
+            mFinishDates.start(time, a);
         }
 
+    private:
+        FinishCalendar mFinishDates;
     };
 
 } // namespace rcpsp
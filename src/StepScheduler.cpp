@@ -22,57 +22,15 @@
  */
 
 #include <devs/StepScheduler.hpp>
-#include <policy/FIFOPolicy.hpp>
+#include <policy/RuntimePolicy.hpp>
 
 namespace rcpsp {
 
-    class StepScheduler : public devs::StepScheduler
-    {
-    public:
-        StepScheduler(const vle::devs::DynamicsInit& init,
-                      const vle::devs::InitEventList& events) :
-            devs::StepScheduler(init, events)
-        {
-            mPolicy = new FIFOPolicy(mWaitingActivities);
-        }
-
-        virtual void add(Activity* a)
-        { mPolicy->add(a); }
-
-        virtual bool another() const
-        { return mPolicy->another(); }
-
-        virtual bool demand() const
-        { return mPolicy->demand(); }
-
-        virtual bool empty() const
-        { return mWaitingActivities.empty(); }
-
-        virtual bool next()
-        { return mPolicy->next(); }
-
-        virtual void remove(Activity* a)
-        {
-            WaitingActivities::iterator it =
-                std::find(mWaitingActivities.begin(),
-                          mWaitingActivities.end(), a);
-
-            mWaitingActivities.erase(it);
-        }
-
-        virtual void reset()
-        { mPolicy->reset(); }
-
-        virtual Activity* select() const
-        { return mPolicy->select(); }
-
-        virtual vle::value::Value* observe() const
-        { return mWaitingActivities.toValue(); }
-
-    private:
-        WaitingActivities mWaitingActivities;
-        StepSchedulingPolicy* mPolicy;
-    };
+    /**
+     * The step scheduler with the policy named by the "policy" port of
+     * its condition.
+     */
+    typedef devs::StepScheduler < RuntimePolicy > StepScheduler;
 
 } // namespace rcpsp
 
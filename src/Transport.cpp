@@ -25,16 +25,15 @@
 
 #include <vle/utils/Trace.hpp>
 
-#include <data/Activity.hpp>
 #include <data/Problem.hpp>
+#include <data/Run.hpp>
+#include <data/Time.hpp>
+#include <data/TransitCalendar.hpp>
 
 namespace rcpsp {
 
     class Transport : public vle::devs::Dynamics
     {
-        typedef std::vector < Activity* > Activities;
-        typedef std::vector < vle::devs::Time > Dates;
-
     public:
         Transport(const vle::devs::DynamicsInit& init,
                   const vle::devs::InitEventList& events) :
@@ -46,7 +45,6 @@ namespace rcpsp {
 
         vle::devs::Time init(const vle::devs::Time& /* time */)
         {
-            mSigma = vle::devs::infinity;
             mLastTime = 0;
             return vle::devs::infinity;
         }
@@ -54,32 +52,30 @@ namespace rcpsp {
         void output(const vle::devs::Time& time,
                     vle::devs::ExternalEventList& output) const
         {
-            unsigned int i = 0;
-
-            for(Activities::const_iterator it = mActivities.begin();
-                it != mActivities.end(); ++it, ++i) {
-
-                if (time == mOutDates[i]) {
-                    vle::devs::ExternalEvent* ee =
-                        new vle::devs::ExternalEvent("out");
-
-                    ee << vle::devs::attribute("location",
-                                               (*it)->location().name());
-                    ee << vle::devs::attribute("activity", (*it)->toValue());
-                    output.push_back(ee);
-                }
+            for(TransitCalendar::const_iterator it = mActivities.begin();
+                it != mActivities.end() and
+                    reached(it->first, time); ++it) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("out");
+
+                ee << vle::devs::attribute("location",
+                                           it->second->location().name());
+                ee << vle::devs::attribute("activity",
+                                           it->second->toEventValue());
+                output.push_back(ee);
             }
         }
 
         vle::devs::Time timeAdvance() const
         {
+            vle::devs::Time sigma = mActivities.next(mLastTime);
 
             TraceModel(
                 vle::fmt(" [%1%:%2%] -> ta = %3% ; n = %4%") %
                 getModel().getParentName() % getModelName() %
-                mSigma % mOutDates.size());
+                sigma % mActivities.size());
 
-            return mSigma;
+            return sigma;
         }
 
         void internalTransition(const vle::devs::Time& time)
@@ -89,27 +85,7 @@ namespace rcpsp {
                 getModel().getParentName() % getModelName() %
                 time);
 
-            Activities::iterator ita = mActivities.begin();
-            Dates::iterator itd = mOutDates.begin();
-
-            while (ita != mActivities.end()) {
-                if (*itd == time) {
-                    mOutDates.erase(itd);
-                    mActivities.erase(ita);
-                    ita = mActivities.begin();
-                    itd = mOutDates.begin();
-                } else {
-                    ++ita;
-                    ++itd;
-                }
-            }
-            if (mOutDates.empty()) {
-                mSigma = vle::devs::infinity;
-            } else {
-                double min = *min_element(mOutDates.begin(), mOutDates.end());
-
-                mSigma = min - time;
-            }
+            mActivities.removeArrived(time);
             mLastTime = time;
         }
 
@@ -160,33 +136,17 @@ namespace rcpsp {
 
                         }
 
-                        if (mOutDates.empty()) {
-                            mSigma = outDate - time;
-                        } else {
-                            mSigma -= time - mLastTime;
-                            if (outDate < time + mSigma) {
-                                mSigma = outDate - time;
-                            }
-                        }
-                        mOutDates.push_back(outDate);
-                        mLastTime = time;
+                        mActivities.push(a, outDate);
 
                         TraceModel(
                             vle::fmt(" [%1%:%2%] at %3% -> next date = %4%") %
                             getModel().getParentName() % getModelName() %
-                            time % (time + mSigma));
-
-                        mActivities.push_back(a);
-                    } else {
-                        if (not mOutDates.empty()) {
-                            mSigma -= time - mLastTime;
-                            mLastTime = time;
-                        }
+                            time % mActivities.begin()->first);
                     }
-
                 }
                 ++it;
             }
+            mLastTime = time;
         }
 
         vle::value::Value* observation(
@@ -195,9 +155,9 @@ namespace rcpsp {
             if (event.onPort("transport")) {
                 vle::value::Set* value = new vle::value::Set;
 
-                for(Activities::const_iterator it = mActivities.begin();
+                for(TransitCalendar::const_iterator it = mActivities.begin();
                     it != mActivities.end(); ++it) {
-                    value->add(new vle::value::String((*it)->name()));
+                    value->add(new vle::value::String(it->second->name()));
                 }
                 return value;
             }
@@ -205,15 +165,15 @@ namespace rcpsp {
         }
 
     private:
+        Run mRun;
+
         // parameters
         std::string mLocation;
         Durations mDurations;
 
         // state
-        vle::devs::Time mSigma;
         vle::devs::Time mLastTime;
-        Activities mActivities;
-        Dates mOutDates;
+        TransitCalendar mActivities;
     };
 
 } // namespace rcpsp
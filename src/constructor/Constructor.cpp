@@ -24,6 +24,7 @@
 #include <vle/devs/Executive.hpp>
 
 #include <data/Problem.hpp>
+#include <data/Run.hpp>
 
 #include <fstream>
 
@@ -110,6 +111,7 @@ namespace rcpsp {
         }
 
     private:
+        Run mRun;
         Locations mLocations;
     };
 
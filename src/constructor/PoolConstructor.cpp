@@ -22,11 +22,19 @@
  */
 
 #include <vle/devs/Executive.hpp>
+#include <vle/value/Boolean.hpp>
 
 #include <data/Problem.hpp>
+#include <data/Run.hpp>
 
 namespace rcpsp {
 
+    /**
+     * Build the pool bank of a location: a single PoolBank model holds
+     * all its pools and answers the whole demands of the assignment. The
+     * resources released by the bank are published through the assignment
+     * on the "released" port of the coupled model.
+     */
     class PoolConstructor : public vle::devs::Executive
     {
     public:
@@ -39,9 +47,45 @@ namespace rcpsp {
 
         virtual ~PoolConstructor() { }
 
-        void createPool(const std::string& name, const pool_t& pool)
+        void createPoolBank(const std::string& name)
         {
             // condition
+            vle::value::Value* value = buildPools();
+
+            conditions().get("cond_pool_bank").setValueToPort(
+                "pools", *value);
+            conditions().get("cond_pool_bank").setValueToPort(
+                "publish", vle::value::Boolean(true));
+            delete value;
+
+            // create model
+            createModelFromClass("PoolBank", name);
+
+            // connections
+            addConnection("assignment", "demand", name, "demand");
+            addConnection("assignment", "release", name, "release");
+
+            addConnection(name, "available", "assignment", "available");
+            addConnection(name, "released", "assignment", "released");
+        }
+
+        vle::devs::Time init(const vle::devs::Time& /* time */)
+        {
+            addInputPort("assignment", "released");
+            addOutputPort("assignment", "released");
+            addConnection("assignment", "assign", coupledmodelName(),
+                          "assign");
+            addConnection("assignment", "released", coupledmodelName(),
+                          "released");
+            createPoolBank("pool_bank");
+            return vle::devs::infinity;
+        }
+
+    private:
+        /** The value of the pool condition: [name, type, resources]. */
+        static vle::value::Value* buildPool(const std::string& name,
+                                            const pool_t& pool)
+        {
             vle::value::Set* value = new vle::value::Set;
 
             value->add(new vle::value::String(name));
@@ -58,32 +102,22 @@ namespace rcpsp {
                 resources->add(resource);
             }
             value->add(resources);
-
-            conditions().get("cond_pool").setValueToPort(
-                "pool", *value);
-
-            // create models
-            createModelFromClass("Pool", name);
-
-            // connections
-            addConnection("assignment", "assign", name, "assign");
-            addConnection("assignment", "demand", name, "demand");
-            addConnection("assignment", "release", name, "release");
-
-            addConnection(name, "available", "assignment", "available");
-            addConnection(name, "assign", coupledmodelName(), "assign");
+            return value;
         }
 
-        vle::devs::Time init(const vle::devs::Time& /* time */)
+        /** The set of the values of all the pools. */
+        vle::value::Set* buildPools() const
         {
+            vle::value::Set* pools = new vle::value::Set;
+
             for (pools_t::const_iterator it = mPools.pools().begin();
                  it != mPools.pools().end(); ++it) {
-                createPool(it->first, it->second);
+                pools->add(buildPool(it->first, it->second));
             }
-            return vle::devs::infinity;
+            return pools;
         }
 
-    private:
+        Run mRun;
         Pools mPools;
     };
 
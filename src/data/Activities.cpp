@@ -27,39 +27,38 @@
 
 namespace rcpsp {
 
-vle::devs::Time Activities::next(const vle::devs::Time& time) const
+void WaitingActivities::erase(const Activity* a)
 {
-    vle::devs::Time min = vle::devs::infinity;
+    handles_t::iterator it = mHandles.find(a);
 
-    for (Activities::const_iterator it = begin(); it != end(); ++it) {
-        if (min > (*it)->temporalConstraints().earlyStartTime()) {
-            min = (*it)->temporalConstraints().earlyStartTime();
-        }
+    if (it != mHandles.end()) {
+        mQueue.erase(it->second);
+        mHandles.erase(it);
     }
-    return min - time;
 }
 
-void Activities::removeStartingActivities()
+WaitingActivities::const_iterator WaitingActivities::find(
+    const Activity* a) const
 {
-    for (Activities::const_iterator it = mStartingActivities.begin();
-         it != mStartingActivities.end(); ++it) {
-        for (Activities::iterator it2 = begin(); it2 != end(); ++it2) {
-            if (*it == *it2) {
-                erase(it2);
-                break;
-            }
-        }
-    }
-    mStartingActivities.clear();
+    handles_t::const_iterator it = mHandles.find(a);
+
+    return it == mHandles.end() ? end() : const_iterator(it->second);
 }
 
-void Activities::starting(const vle::devs::Time& time)
+void WaitingActivities::push(Activity* a, double priority)
 {
-    for (Activities::const_iterator it = begin(); it != end(); ++it) {
-        if ((*it)->starting(time)) {
-            (*it)->wait(time);
-            mStartingActivities.push_back(*it);
-        }
+    mHandles[a] = mQueue.insert(Entry(priority, mSequence++, a)).first;
+}
+
+void WaitingActivities::reprioritize(const Activity* a, double priority)
+{
+    handles_t::iterator it = mHandles.find(a);
+
+    if (it != mHandles.end() and it->second->priority != priority) {
+        Entry entry(priority, it->second->sequence, it->second->activity);
+
+        mQueue.erase(it->second);
+        it->second = mQueue.insert(entry).first;
     }
 }
 
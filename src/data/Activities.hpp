@@ -27,6 +27,8 @@
 #include <deque>
 #include <ostream>
 #include <list>
+#include <map>
+#include <set>
 #include <vector>
 
 #include <data/Activity.hpp>
@@ -41,7 +43,7 @@ public:
     Activities()
     { }
 
-    Activities(const Activities& a) : std::vector < Activity* >(a)
+    Activities(const Activities& a) : std::vector < Activity* >()
     {
         for(const_iterator it = a.begin(); it != a.end(); ++it)
             push_back(new Activity(**it));
@@ -54,6 +56,7 @@ public:
 
         for (unsigned int i = 0; i < set->size(); ++i) {
             push_back(new Activity(set->get(i)));
+            back()->attach(0, i);
         }
     }
 
@@ -66,8 +69,6 @@ public:
         std::vector < Activity* >::clear();
     }
 
-    vle::devs::Time next(const vle::devs::Time& time) const;
-
     vle::value::Value* observe_activity() const
     {
         vle::value::Set* list = new vle::value::Set;
@@ -93,11 +94,12 @@ public:
         vle::value::Set* list = new vle::value::Set;
 
         for (Activities::const_iterator it = begin(); it != end(); ++it) {
-            const Resources* resources = (*it)->allocatedResources();
+            const Resources& resources = (*it)->allocatedResources();
 
-            for (Resources::const_iterator itr = resources->begin();
-                 itr != resources->end(); ++itr) {
-                list->add(new vle::value::String((*itr)->name()));
+            for (Resources::const_iterator itr = resources.begin();
+                 itr != resources.end(); ++itr) {
+                list->add(new vle::value::String(
+                              Resources::resource(*itr).name()));
             }
         }
         return list;
@@ -105,41 +107,32 @@ public:
 
     vle::value::Value* observe_used_resource_types() const
     {
-        std::map < std::string, int > resourceNumber;
+        ResourceTypes resourceNumber;
 
         for (Activities::const_iterator it = begin(); it != end(); ++it) {
-            const Resources* resources = (*it)->allocatedResources();
-
-            for (Resources::const_iterator itr = resources->begin();
-                 itr != resources->end(); ++itr) {
-                if (resourceNumber.find((*itr)->type()) ==
-                    resourceNumber.end()) {
-                    resourceNumber[(*itr)->type()] = 0;
-                }
-                resourceNumber[(*itr)->type()]++;
+            const Resources& resources = (*it)->allocatedResources();
+
+            for (Resources::const_iterator itr = resources.begin();
+                 itr != resources.end(); ++itr) {
+                ++resourceNumber[Resources::resource(*itr).type()];
             }
         }
 
         vle::value::Set* list = new vle::value::Set;
 
-        for (std::map < std::string, int >::const_iterator it =
-                 resourceNumber.begin(); it != resourceNumber.end(); ++it) {
-            vle::value::Set* value = new vle::value::Set;
+        for (unsigned int type = 0; type < resourceNumber.size(); ++type) {
+            if (resourceNumber[type] > 0) {
+                vle::value::Set* value = new vle::value::Set;
 
-            value->add(new vle::value::String(it->first));
-            value->add(new vle::value::Integer(it->second));
-            list->add(value);
+                value->add(new vle::value::String(
+                               Symbols::resourceTypes().name(type)));
+                value->add(new vle::value::Integer(resourceNumber[type]));
+                list->add(value);
+            }
         }
         return list;
     }
 
-    void removeStartingActivities();
-
-    void starting(const vle::devs::Time& time);
-
-    const result_t& startingActivities() const
-    { return mStartingActivities; }
-
     vle::value::Value* toValue() const
     {
         vle::value::Set* value = new vle::value::Set;
@@ -152,16 +145,94 @@ public:
 
 private:
     friend std::ostream& operator<<(std::ostream& o, const Activities& a);
-
-    result_t mStartingActivities;
 };
 
-class WaitingActivities : public std::deque < Activity* >
+/**
+ * The activities waiting at a location, ordered by the priority given by
+ * the scheduling policy (lowest first) then by arrival. An ordered tree
+ * indexed by activity makes push, erase and reprioritize O(log n), and
+ * the iterators stay valid while other activities come and go.
+ */
+class WaitingActivities
 {
+    struct Entry
+    {
+        Entry(double priority, unsigned int sequence, Activity* activity) :
+            priority(priority), sequence(sequence), activity(activity)
+        { }
+
+        bool operator<(const Entry& e) const
+        {
+            return priority < e.priority or
+                (priority == e.priority and sequence < e.sequence);
+        }
+
+        double priority;
+        unsigned int sequence;
+        Activity* activity;
+    };
+
+    typedef std::set < Entry > queue_t;
+    typedef std::map < const Activity*, queue_t::iterator > handles_t;
+
 public:
-    WaitingActivities()
+    class const_iterator
+    {
+    public:
+        const_iterator()
+        { }
+
+        const_iterator(queue_t::const_iterator it) : mIt(it)
+        { }
+
+        Activity* operator*() const
+        { return mIt->activity; }
+
+        double priority() const
+        { return mIt->priority; }
+
+        const_iterator& operator++()
+        {
+            ++mIt;
+            return *this;
+        }
+
+        bool operator==(const const_iterator& it) const
+        { return mIt == it.mIt; }
+
+        bool operator!=(const const_iterator& it) const
+        { return mIt != it.mIt; }
+
+    private:
+        queue_t::const_iterator mIt;
+    };
+
+    WaitingActivities() : mSequence(0)
     { }
 
+    const_iterator begin() const
+    { return const_iterator(mQueue.begin()); }
+
+    bool empty() const
+    { return mQueue.empty(); }
+
+    const_iterator end() const
+    { return const_iterator(mQueue.end()); }
+
+    void erase(const Activity* a);
+
+    const_iterator find(const Activity* a) const;
+
+    Activity* front() const
+    { return mQueue.begin()->activity; }
+
+    void push(Activity* a, double priority = 0);
+
+    void reprioritize(const Activity* a, double priority);
+
+    unsigned int size() const
+    { return mQueue.size(); }
+
     vle::value::Value* toValue() const
     {
         vle::value::Set* list = new vle::value::Set;
@@ -171,6 +242,11 @@ public:
         }
         return list;
     }
+
+private:
+    queue_t mQueue;
+    handles_t mHandles;
+    unsigned int mSequence;
 };
 
 } // namespace rcpsp
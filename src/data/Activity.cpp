@@ -22,62 +22,82 @@
  */
 
 #include <data/Activity.hpp>
+#include <data/ActivityStore.hpp>
+#include <data/Time.hpp>
+
+#include <boost/static_assert.hpp>
+
+#include <algorithm>
 
 namespace rcpsp {
 
-Activity::Activity(const vle::value::Value* value)
+// the objects built at every event must come from the arena
+BOOST_STATIC_ASSERT(sizeof(Activity) <= Arena::MAX_SIZE);
+BOOST_STATIC_ASSERT(sizeof(Step) <= Arena::MAX_SIZE);
+BOOST_STATIC_ASSERT(sizeof(Steps) <= Arena::MAX_SIZE);
+
+Activity::Activity(const vle::value::Value* value) :
+    mStore(0), mHandle(0), mSuccessors(0), mSuccessorsWork(0)
 {
     const vle::value::Set* set = dynamic_cast < const vle::value::Set* >(value);
 
     mName = vle::value::toString(set->get(0));
-    mSteps = new Steps(set->get(1));
+    mSteps.reset(new Steps(set->get(1)));
     mTemporalConstraints = TemporalConstraints(set->get(2));
+    mState.step = mSteps->size();
     if (set->size() > 3) {
-        if (vle::value::toSet(set->get(3)).size() == 0) {
-            mAllocatedResources = 0;
-        } else {
-            mAllocatedResources = new Resources(set->get(3));
-        }
+        mAllocatedResources = Resources(set->get(3));
         if (set->size() > 4) {
-            std::string value = vle::value::toString(set->get(4));
+            const vle::value::Value* step = set->get(4);
 
-            if (value == "DONE") {
-                mStepIterator = mSteps->end();
-            } else {
-                mStepIterator = mSteps->find(value);
+            // the step is given by its index, or by its name in the former
+            // format ("DONE" once the activity is finished)
+            if (step->isInteger()) {
+                mState.step = vle::value::toInteger(step);
+            } else if (vle::value::toString(step) != "DONE") {
+                mState.step = mSteps->find(vle::value::toString(step)) -
+                    mSteps->begin();
             }
         }
-    } else {
-        mAllocatedResources = 0;
-        mStepIterator = mSteps->end();
     }
+    updateDemand();
 }
 
-void Activity::assign(Resources* r)
+Activity::Activity(Blob::Reader& reader) :
+    mName(reader.getString()), mSteps(new Steps(reader)),
+    mTemporalConstraints(reader), mStore(0), mHandle(reader.getInteger()),
+    mSuccessors(reader.getInteger()), mSuccessorsWork(reader.getDouble()),
+    mAllocatedResources(reader)
 {
-    if (mAllocatedResources) {
-        for (Resources::const_iterator it = r->begin(); it != r->end(); ++it) {
-            mAllocatedResources->push_back(*it);
-        }
-        delete r;
-    } else {
-        mAllocatedResources = r;
-    }
+    mState.step = reader.getInteger();
+    updateDemand();
 }
 
-ResourceConstraints Activity::buildResourceConstraints() const
+void Activity::assign(const Resources& r)
 {
-    if (mStepIterator != mSteps->end()) {
-        return (*mStepIterator)->buildResourceConstraints(mAllocatedResources);
+    mDemand.assign(r);
+    mAllocatedResources.add(r);
+}
+
+Activity* Activity::build(const vle::value::Value& value)
+{
+    if (Blob::isBlob(value)) {
+        Blob::Reader reader(Blob::toBlob(value));
+
+        if (reader.getBoolean()) {
+            return ActivityStore::restore(reader);
+        } else {
+            return new Activity(reader);
+        }
     } else {
-        return ResourceConstraints();
+        return new Activity(&value);
     }
 }
 
 bool Activity::checkResourceConstraint() const
 {
-    if (mStepIterator != mSteps->end()) {
-        return (*mStepIterator)->checkResourceConstraint(*mAllocatedResources);
+    if (mState.step < mSteps->size()) {
+        return mDemand.empty();
     } else {
         return false;
     }
@@ -85,8 +105,8 @@ bool Activity::checkResourceConstraint() const
 
 bool Activity::done(const vle::devs::Time& time) const
 {
-    if (not mSteps->empty() and mStepIterator != mSteps->end()) {
-        return (*mStepIterator)->done(time);
+    if (not mSteps->empty() and mState.step < mSteps->size()) {
+        return reached(mState.startDate + current()->duration(), time);
     } else {
         return true;
     }
@@ -94,53 +114,54 @@ bool Activity::done(const vle::devs::Time& time) const
 
 void Activity::finish(const vle::devs::Time& time)
 {
-    if (not mSteps->empty() and mStepIterator != mSteps->end()) {
-        (*mStepIterator)->finish(time);
-        ++mStepIterator;
+    if (not mSteps->empty() and mState.step < mSteps->size()) {
+        mState.finishDate = time;
+        ++mState.step;
     } else {
         //TODO exception
     }
 }
 
+Resources Activity::finishingResources() const
+{
+    if (mState.step + 1 >= mSteps->size()) {
+        return mAllocatedResources;
+    } else {
+        Resources resources(mAllocatedResources);
+
+        resources.remove(keptResources((*mSteps)[mState.step + 1]));
+        return resources;
+    }
+}
+
 void Activity::release()
 {
     if (end()) {
-        mAllocatedResources = 0;
+        mAllocatedResources.clear();
     } else {
-        Resources::iterator it = mAllocatedResources->begin();
-
-        while (it != mAllocatedResources->end()) {
-            if (not (*mStepIterator)->needAgain((*it)->type())) {
-                mAllocatedResources->erase(it);
-                it = mAllocatedResources->begin();
-            } else {
-                ++it;
-            }
-        }
+        Resources kept = keptResources(current());
+
+        mAllocatedResources.swap(kept);
     }
+    updateDemand();
 }
 
-Resources* Activity::releasedResources() const
+Resources Activity::releasedResources() const
 {
     if (end()) {
         return mAllocatedResources;
     } else {
-        Resources* resources = new Resources;
+        Resources resources(mAllocatedResources);
 
-        for (Resources::const_iterator it = mAllocatedResources->begin();
-             it != mAllocatedResources->end(); ++it) {
-            if (not (*mStepIterator)->needAgain((*it)->type())) {
-                resources->push_back(*it);
-            }
-        }
+        resources.remove(keptResources(current()));
         return resources;
     }
 }
 
 vle::devs::Time Activity::remainingTime(const vle::devs::Time& time) const
 {
-    if (not mSteps->empty() and mStepIterator != mSteps->end()) {
-        return (*mStepIterator)->remainingTime(time);
+    if (not mSteps->empty() and mState.step < mSteps->size()) {
+        return current()->duration() - (time - mState.startDate);
     } else {
         return 0;
     }
@@ -148,8 +169,8 @@ vle::devs::Time Activity::remainingTime(const vle::devs::Time& time) const
 
 const ResourceConstraints& Activity::resourceConstraints() const
 {
-    if (not mSteps->empty() and mStepIterator != mSteps->end()) {
-        return (*mStepIterator)->resourceConstraints();
+    if (not mSteps->empty() and mState.step < mSteps->size()) {
+        return current()->resourceConstraints();
     } else {
         //TODO exception
     }
@@ -157,8 +178,8 @@ const ResourceConstraints& Activity::resourceConstraints() const
 
 void Activity::start(const vle::devs::Time& time)
 {
-    if (not mSteps->empty() and mStepIterator != mSteps->end() ) {
-        (*mStepIterator)->start(time);
+    if (not mSteps->empty() and mState.step < mSteps->size() ) {
+        mState.startDate = time;
     } else {
         //TODO exception
     }
@@ -177,6 +198,33 @@ bool Activity::starting(const vle::devs::Time& time) const
     }
 }
 
+void Activity::swap(Activity& a)
+{
+    mName.swap(a.mName);
+    mSteps.swap(a.mSteps);
+    std::swap(mTemporalConstraints, a.mTemporalConstraints);
+    std::swap(mStore, a.mStore);
+    std::swap(mHandle, a.mHandle);
+    std::swap(mSuccessors, a.mSuccessors);
+    std::swap(mSuccessorsWork, a.mSuccessorsWork);
+    std::swap(mState, a.mState);
+    mAllocatedResources.swap(a.mAllocatedResources);
+    mDemand.swap(a.mDemand);
+}
+
+vle::value::Value* Activity::toEventValue() const
+{
+    Blob* blob = new Blob;
+
+    blob->putBoolean(mStore != 0);
+    if (mStore) {
+        mStore->write(*this, *blob);
+    } else {
+        write(*blob);
+    }
+    return blob;
+}
+
 vle::value::Value* Activity::toValue() const
 {
     vle::value::Set* value = new vle::value::Set();
@@ -184,38 +232,67 @@ vle::value::Value* Activity::toValue() const
     value->add(new vle::value::String(mName));
     value->add(mSteps->toValue());
     value->add(mTemporalConstraints.toValue());
-    if (mAllocatedResources) {
-        value->add(mAllocatedResources->toValue());
-    } else {
-        value->add(new vle::value::Set);
-    }
-    if (not mSteps->empty() and mStepIterator != mSteps->end()) {
-        value->add(new vle::value::String((*mStepIterator)->name()));
-    } else {
-        value->add(new vle::value::String("DONE"));
-    }
+    value->add(mAllocatedResources.toValue());
+    value->add(new vle::value::Integer(mState.step));
     return value;
 }
 
 void Activity::wait(const vle::devs::Time& time)
 {
     if (not mSteps->empty()) {
-        mStepIterator = mSteps->begin();
-        (*mStepIterator)->wait(time);
+        mState.step = 0;
+        mState.waitDate = time;
+        updateDemand();
     } else {
         //TODO exception
     }
 }
 
+Resources Activity::keptResources(const Step* step) const
+{
+    const ResourceConstraints& constraints = step->resourceConstraints();
+    Resources kept;
+
+    for (ResourceConstraints::const_iterator it = constraints.begin();
+         it != constraints.end(); ++it) {
+        if (it->same()) {
+            kept.add(mAllocatedResources.ofType(it->type()));
+        }
+    }
+    return kept;
+}
+
+void Activity::write(Blob& blob) const
+{
+    blob.putString(mName);
+    mSteps->write(blob);
+    mTemporalConstraints.write(blob);
+    blob.putInteger(mHandle);
+    blob.putInteger(mSuccessors);
+    blob.putDouble(mSuccessorsWork);
+    mAllocatedResources.write(blob);
+    blob.putInteger(mState.step);
+}
+
+void Activity::updateDemand()
+{
+    if (not mSteps->empty() and mState.step < mSteps->size()) {
+        mDemand.reset(current()->resourceConstraints(),
+                      &mAllocatedResources);
+    } else {
+        mDemand.clear();
+    }
+}
+
 std::ostream& operator<<(std::ostream& o, const Activity& a)
 {
     o << "[ " << a.mName << " , " << *a.mSteps;
     if (not a.end()) {
-        o << " < " << (*a.mStepIterator)->name() << " >";
+        o << " < " << a.current()->name() << " >";
     }
     o << " , " << a.mTemporalConstraints << " ]";
-    if (a.mAllocatedResources) {
-        o << ", " << *a.mAllocatedResources;
+    if (not a.mAllocatedResources.empty()) {
+        o << ", " << a.mAllocatedResources;
     }
     return o;
 }
@@ -24,127 +24,238 @@
 #ifndef __ACTIVITY_HPP
 #define __ACTIVITY_HPP 1
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include <boost/shared_ptr.hpp>
+
 #include <vle/devs/ExternalEvent.hpp>
 #include <vle/value/Value.hpp>
 
+#include <data/Arena.hpp>
 #include <data/Resources.hpp>
 #include <data/Steps.hpp>
 #include <data/TemporalConstraints.hpp>
 
 namespace rcpsp {
 
-    class Activity
+    class ActivityStore;
+
+    /**
+     * The runtime state of an activity: the index of the current step (the
+     * number of steps once the activity is finished) and its dates. The
+     * steps themselves are shared and never change during a run.
+     */
+    struct ActivityState
+    {
+        ActivityState() : waitDate(vle::devs::infinity),
+                          startDate(vle::devs::infinity),
+                          finishDate(vle::devs::infinity)
+        { }
+
+        unsigned int step;
+        vle::devs::Time waitDate;
+        vle::devs::Time startDate;
+        vle::devs::Time finishDate;
+    };
+
+    class Activity : public ArenaObject
     {
     public:
         Activity(const std::string& name,
                  const TemporalConstraints& temporalConstraints) :
             mName(name), mSteps(new Steps()),
             mTemporalConstraints(temporalConstraints),
-            mAllocatedResources(0)
+            mStore(0), mHandle(0), mSuccessors(0), mSuccessorsWork(0)
+        { mState.step = mSteps->size(); }
+
+        Activity(const Activity& a) :
+            mName(a.mName), mSteps(a.mSteps),
+            mTemporalConstraints(a.mTemporalConstraints),
+            mStore(a.mStore), mHandle(a.mHandle),
+            mSuccessors(a.mSuccessors), mSuccessorsWork(a.mSuccessorsWork),
+            mState(a.mState), mAllocatedResources(a.mAllocatedResources),
+            mDemand(a.mDemand)
         { }
 
-        Activity(const Activity& a) : mName(a.mName),
-                                      mSteps(new Steps(*a.mSteps)),
-                                      mTemporalConstraints(a.mTemporalConstraints),
-                                      mAllocatedResources(a.mAllocatedResources)
-        {
-            if (not mSteps->empty() and a.mStepIterator != a.mSteps->end()) {
-                mStepIterator = mSteps->find((*a.mStepIterator)->name());
-            } else {
-                mStepIterator = mSteps->begin();
-            }
-        }
-
         Activity(const vle::value::Value* value);
 
+        Activity(Blob::Reader& reader);
+
         virtual ~Activity()
-        { delete mSteps; }
+        { }
 
+        /**
+         * Add a step to the definition of the activity. The steps are
+         * shared by the copies of the activity: an activity sharing its
+         * steps takes its own copy of them first.
+         */
         void addStep(Step* step)
-        { mSteps->push_back(step); }
+        {
+            if (not mSteps.unique()) {
+                mSteps.reset(new Steps(*mSteps));
+            }
+            mSteps->push_back(step);
+            mState.step = mSteps->size();
+        }
 
-        const Resources* allocatedResources() const
+        const Resources& allocatedResources() const
         { return mAllocatedResources; }
 
-        void assign(Resources* r);
+        void assign(const Resources& r);
 
-        bool begin() const
-        { return mStepIterator == mSteps->begin(); }
+        void attach(const ActivityStore* store, unsigned int handle)
+        {
+            mStore = store;
+            mHandle = handle;
+        }
 
-        static Activity* build(const vle::value::Value& value)
-        { return new Activity(&value); }
+        bool begin() const
+        { return mState.step == 0; }
 
-        ResourceConstraints buildResourceConstraints() const;
+        static Activity* build(const vle::value::Value& value);
 
         bool checkResourceConstraint() const;
 
         const Step* current() const
-        { return *mStepIterator; }
+        { return (*mSteps)[mState.step]; }
+
+        /**
+         * The resources the current step still needs, updated when the
+         * step changes and when resources are assigned.
+         */
+        const ResourceDemand& demand() const
+        { return mDemand; }
 
         bool done(const vle::devs::Time& time) const;
 
+        /** The total duration of the steps. */
+        vle::devs::Time duration() const
+        { return mSteps->work(0); }
+
         bool end() const
-        { return mStepIterator == mSteps->end(); }
+        { return mState.step == mSteps->size(); }
 
         void finish(const vle::devs::Time& time);
 
+        /**
+         * The allocated resources the current step gives back when it
+         * finishes: the next step keeps the ones of its "same"
+         * constraints.
+         */
+        Resources finishingResources() const;
+
         static const vle::value::Value& get(const vle::devs::ExternalEvent* ee)
         { return ee->getAttributeValue("activity"); }
 
+        /** The position of the activity in the activities condition. */
+        unsigned int handle() const
+        { return mHandle; }
+
         const Location& location() const
-        { return (*mStepIterator)->location(); }
+        { return current()->location(); }
 
         const std::string& name() const
         { return mName; }
 
-        const Activity& operator=(const Activity& a)
+        Activity& operator=(Activity a)
         {
-            mName = a.mName;
-            mSteps = new Steps(*a.mSteps);
-            mTemporalConstraints = a.mTemporalConstraints;
-            if (not mSteps->empty() and a.mStepIterator != a.mSteps->end()) {
-                mStepIterator = mSteps->find((*a.mStepIterator)->name());
-            } else {
-                mStepIterator = mSteps->begin();
-            }
+            swap(a);
             return *this;
         }
 
         void release();
 
-        Resources* releasedResources() const;
+        Resources releasedResources() const;
+
+        /**
+         * The number of steps after the current one.
+         */
+        unsigned int remainingSteps() const
+        { return end() ? 0 : mSteps->size() - mState.step - 1; }
 
         vle::devs::Time remainingTime(const vle::devs::Time& time) const;
 
+        /**
+         * The total duration of the current step and of the next ones.
+         */
+        vle::devs::Time remainingWork() const
+        { return mSteps->work(mState.step); }
+
         const ResourceConstraints& resourceConstraints() const;
 
         void start(const vle::devs::Time& time);
 
         bool starting(const vle::devs::Time& time) const;
 
+        const ActivityStore* store() const
+        { return mStore; }
+
+        const Steps& steps() const
+        { return *mSteps; }
+
+        /**
+         * The number of the activities which follow this one in the
+         * precedence graph, directly or not.
+         */
+        unsigned int successors() const
+        { return mSuccessors; }
+
+        void successors(unsigned int number, const vle::devs::Time& work)
+        {
+            mSuccessors = number;
+            mSuccessorsWork = work;
+        }
+
+        /** The total duration of the steps of the successors. */
+        const vle::devs::Time& successorsWork() const
+        { return mSuccessorsWork; }
+
+        void swap(Activity& a);
+
         const TemporalConstraints& temporalConstraints() const
         { return mTemporalConstraints; }
 
+        void temporalConstraints(const TemporalConstraints& tc)
+        { mTemporalConstraints = tc; }
+
+        /**
+         * Build the value sent in the events, a blob holding the handle
+         * and the state of the activity if it belongs to a store, the
+         * whole activity otherwise.
+         */
+        vle::value::Value* toEventValue() const;
+
         vle::value::Value* toValue() const;
 
         void wait(const vle::devs::Time& time);
 
+        void write(Blob& blob) const;
+
     private:
+        /**
+         * The allocated resources a step needs again.
+         */
+        Resources keptResources(const Step* step) const;
+
+        void updateDemand();
+
+        friend class ActivityStore;
         friend std::ostream& operator<<(std::ostream& o, const Activity& a);
 
         std::string mName;
-        Steps* mSteps;
+        boost::shared_ptr < Steps > mSteps;
         TemporalConstraints mTemporalConstraints;
+        const ActivityStore* mStore;
+        unsigned int mHandle;
+        unsigned int mSuccessors;
+        vle::devs::Time mSuccessorsWork;
 
         // state
-        Steps::iterator mStepIterator;
-        Resources* mAllocatedResources;
-        bool mWaiting;
-        bool mRunning;
-        bool mDone;
+        ActivityState mState;
+        Resources mAllocatedResources;
+        ResourceDemand mDemand;
     };
 
 } // namespace rcpsp
@@ -0,0 +1,97 @@
+/**
+ * @file ActivityStore.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <data/ActivityStore.hpp>
+
+#include <map>
+
+namespace rcpsp {
+
+typedef std::map < unsigned int, const ActivityStore* > stores_t;
+
+// the stores of the runs of the thread, like the arena
+static __thread stores_t* stores = 0;
+static __thread unsigned int lastId = 0;
+
+ActivityStore::ActivityStore(Activities& activities) : mId(++lastId)
+{
+    for (unsigned int i = 0; i < activities.size(); ++i) {
+        activities[i]->attach(this, i);
+        mActivities.push_back(new Activity(*activities[i]));
+    }
+    if (stores == 0) {
+        stores = new stores_t;
+    }
+    (*stores)[mId] = this;
+}
+
+ActivityStore::~ActivityStore()
+{
+    stores->erase(mId);
+    if (stores->empty()) {
+        delete stores;
+        stores = 0;
+    }
+}
+
+const ActivityStore* ActivityStore::find(unsigned int id)
+{
+    if (stores == 0) {
+        return 0;
+    }
+
+    stores_t::const_iterator it = stores->find(id);
+
+    return it == stores->end() ? 0 : it->second;
+}
+
+bool ActivityStore::isHandle(const vle::value::Value& value)
+{
+    if (Blob::isBlob(value)) {
+        Blob::Reader reader(Blob::toBlob(value));
+
+        return reader.getBoolean();
+    }
+    return false;
+}
+
+Activity* ActivityStore::restore(Blob::Reader& reader)
+{
+    const ActivityStore* store = find(reader.getInteger());
+    Activity* a = new Activity(store->get(reader.getInteger()));
+
+    a->mState.step = reader.getInteger();
+    a->mAllocatedResources = Resources(reader);
+    a->updateDemand();
+    return a;
+}
+
+void ActivityStore::write(const Activity& activity, Blob& blob) const
+{
+    blob.putInteger(mId);
+    blob.putInteger(activity.mHandle);
+    blob.putInteger(activity.mState.step);
+    activity.mAllocatedResources.write(blob);
+}
+
+} // namespace rcpsp
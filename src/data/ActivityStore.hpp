@@ -0,0 +1,73 @@
+/**
+ * @file ActivityStore.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ACTIVITY_STORE_HPP
+#define __ACTIVITY_STORE_HPP 1
+
+#include <vle/value/Value.hpp>
+
+#include <data/Activities.hpp>
+
+namespace rcpsp {
+
+/**
+ * The activities of a run, shared by all the models of the simulation.
+ *
+ * When an activity belongs to a store, the events only carry its handle
+ * and its mutable state (current step and allocated resources): the
+ * receiver rebuilds the activity from the stored definition instead of
+ * deserializing every step. The rebuilt activities share the steps of
+ * the store, which is the read-only catalog of the problem.
+ */
+class ActivityStore
+{
+public:
+    ActivityStore(Activities& activities);
+
+    virtual ~ActivityStore();
+
+    static const ActivityStore* find(unsigned int id);
+
+    const Activity& get(unsigned int handle) const
+    { return *mActivities[handle]; }
+
+    unsigned int id() const
+    { return mId; }
+
+    static bool isHandle(const vle::value::Value& value);
+
+    static Activity* restore(Blob::Reader& reader);
+
+    void write(const Activity& activity, Blob& blob) const;
+
+private:
+    ActivityStore(const ActivityStore&);
+    ActivityStore& operator=(const ActivityStore&);
+
+    unsigned int mId;
+    Activities mActivities;
+};
+
+} // namespace rcpsp
+
+#endif
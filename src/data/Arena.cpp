@@ -0,0 +1,138 @@
+/**
+ * @file Arena.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <data/Arena.hpp>
+
+#include <new>
+
+namespace rcpsp {
+
+// one arena per thread: the replications of an experiment may run in
+// several threads of the same process
+static __thread Arena* current = 0;
+
+Arena::Arena() : mCurrent(0), mLeft(0), mUsed(0), mPurge(false)
+{
+    for (unsigned int i = 0; i < CLASSES; ++i) {
+        mFree[i] = 0;
+    }
+}
+
+void* Arena::allocate(std::size_t size)
+{
+    std::size_t n = (size + ALIGNMENT - 1) / ALIGNMENT;
+
+    if (n == 0 or n > CLASSES) {
+        return ::operator new(size);
+    }
+
+    Arena& a = arena();
+    void* p;
+
+    a.mPurge = false;
+    if (a.mFree[n - 1]) {
+        p = a.mFree[n - 1];
+        a.mFree[n - 1] = a.mFree[n - 1]->next;
+    } else {
+        if (a.mLeft < n * ALIGNMENT) {
+            a.mCurrent = static_cast < char* >(::operator new(CHUNK_SIZE));
+            a.mChunks.push_back(a.mCurrent);
+            a.mLeft = CHUNK_SIZE;
+        }
+        p = a.mCurrent;
+        a.mCurrent += n * ALIGNMENT;
+        a.mLeft -= n * ALIGNMENT;
+    }
+    ++a.mUsed;
+    return p;
+}
+
+void Arena::deallocate(void* p, std::size_t size)
+{
+    std::size_t n = (size + ALIGNMENT - 1) / ALIGNMENT;
+
+    if (p == 0) {
+        return;
+    }
+    if (n == 0 or n > CLASSES) {
+        ::operator delete(p);
+        return;
+    }
+
+    Arena& a = arena();
+    Node* node = static_cast < Node* >(p);
+
+    node->next = a.mFree[n - 1];
+    a.mFree[n - 1] = node;
+    if (--a.mUsed == 0 and a.mPurge) {
+        destroy();
+    }
+}
+
+void Arena::purge()
+{
+    Arena& a = arena();
+
+    if (a.mUsed == 0) {
+        destroy();
+    } else {
+        a.mPurge = true;
+    }
+}
+
+std::size_t Arena::used()
+{
+    return arena().mUsed;
+}
+
+Arena& Arena::arena()
+{
+    if (current == 0) {
+        current = new Arena;
+    }
+    return *current;
+}
+
+void Arena::destroy()
+{
+    current->clear();
+    delete current;
+    current = 0;
+}
+
+void Arena::clear()
+{
+    for (std::vector < char* >::iterator it = mChunks.begin();
+         it != mChunks.end(); ++it) {
+        ::operator delete(*it);
+    }
+    mChunks.clear();
+    for (unsigned int i = 0; i < CLASSES; ++i) {
+        mFree[i] = 0;
+    }
+    mCurrent = 0;
+    mLeft = 0;
+    mPurge = false;
+}
+
+} // namespace rcpsp
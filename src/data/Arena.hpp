@@ -0,0 +1,107 @@
+/**
+ * @file Arena.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ARENA_HPP
+#define __ARENA_HPP 1
+
+#include <cstddef>
+#include <vector>
+
+namespace rcpsp {
+
+/**
+ * A size-class allocator for the small objects built and destroyed at
+ * every event (activities, steps, resource sets, blobs...).
+ *
+ * The memory is carved out of large chunks and the freed blocks are kept
+ * in one free list per size class, so an allocation is a pop and a
+ * deallocation a push. Each thread has its own arena, so the runs of
+ * concurrent replications do not share their free lists. The chunks are
+ * given back to the system at the end of a run (see Run), once the last
+ * object is freed.
+ */
+class Arena
+{
+public:
+    /** The objects larger than MAX_SIZE bytes are left to the heap. */
+    enum { ALIGNMENT = 16, CLASSES = 32, MAX_SIZE = ALIGNMENT * CLASSES };
+
+    static void* allocate(std::size_t size);
+
+    static void deallocate(void* p, std::size_t size);
+
+    /**
+     * Give the chunks back to the system now if no object is alive,
+     * otherwise when the last one is freed.
+     */
+    static void purge();
+
+    /**
+     * The number of blocks currently allocated.
+     */
+    static std::size_t used();
+
+private:
+    enum { CHUNK_SIZE = 64 * 1024 };
+
+    struct Node
+    {
+        Node* next;
+    };
+
+    Arena();
+
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    static Arena& arena();
+
+    void clear();
+
+    /** Free the arena of the thread and its chunks. */
+    static void destroy();
+
+    Node* mFree[CLASSES];
+    std::vector < char* > mChunks;
+    char* mCurrent;
+    std::size_t mLeft;
+    std::size_t mUsed;
+    bool mPurge;
+};
+
+/**
+ * Base class of the objects allocated in the arena.
+ */
+class ArenaObject
+{
+public:
+    static void* operator new(std::size_t size)
+    { return Arena::allocate(size); }
+
+    static void operator delete(void* p, std::size_t size)
+    { Arena::deallocate(p, size); }
+};
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file Blob.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <data/Blob.hpp>
+
+#include <boost/static_assert.hpp>
+
+namespace rcpsp {
+
+BOOST_STATIC_ASSERT(sizeof(Blob) <= Arena::MAX_SIZE);
+
+std::string Blob::Reader::getString()
+{
+    unsigned int size = getInteger();
+
+    check(size);
+
+    std::string value(mBlob.mData, mPosition, size);
+
+    mPosition += size;
+    return value;
+}
+
+void Blob::writeFile(std::ostream& out) const
+{
+    writeString(out);
+}
+
+void Blob::writeString(std::ostream& out) const
+{
+    out << "<blob " << mData.size() << " bytes>";
+}
+
+void Blob::writeXml(std::ostream& out) const
+{
+    out << "<blob size=\"" << mData.size() << "\" />";
+}
+
+} // namespace rcpsp
@@ -0,0 +1,155 @@
+/**
+ * @file Blob.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BLOB_HPP
+#define __BLOB_HPP 1
+
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#include <vle/utils/Exception.hpp>
+#include <vle/value/User.hpp>
+#include <vle/value/Value.hpp>
+
+#include <data/Arena.hpp>
+
+namespace rcpsp {
+
+/**
+ * An opaque value holding the binary encoding of the data carried by the
+ * events. A blob costs a single allocation where the equivalent tree of
+ * sets, strings and numbers costs one per node; the identifiers of the
+ * resources, resource types and locations are only meaningful inside the
+ * process that wrote them.
+ */
+class Blob : public vle::value::User, public ArenaObject
+{
+public:
+    // the values of vle may have their own allocation functions
+    using ArenaObject::operator new;
+    using ArenaObject::operator delete;
+
+    /**
+     * Read the values of a blob in the order they were written.
+     */
+    class Reader
+    {
+    public:
+        Reader(const Blob& blob) : mBlob(blob), mPosition(0)
+        { }
+
+        bool getBoolean()
+        { return get < bool >(); }
+
+        double getDouble()
+        { return get < double >(); }
+
+        unsigned int getInteger()
+        { return get < unsigned int >(); }
+
+        std::string getString();
+
+    private:
+        /** Throw if less than size bytes are left to read. */
+        void check(std::string::size_type size) const
+        {
+            if (size > mBlob.mData.size() - mPosition) {
+                throw vle::utils::ModellingError("truncated blob");
+            }
+        }
+
+        template < typename T >
+        T get()
+        {
+            T value;
+
+            check(sizeof(T));
+            std::memcpy(&value, mBlob.mData.data() + mPosition, sizeof(T));
+            mPosition += sizeof(T);
+            return value;
+        }
+
+        const Blob& mBlob;
+        std::string::size_type mPosition;
+    };
+
+    Blob()
+    { }
+
+    Blob(const Blob& blob) : vle::value::User(blob), mData(blob.mData)
+    { }
+
+    virtual ~Blob()
+    { }
+
+    virtual vle::value::Value* clone() const
+    { return new Blob(*this); }
+
+    virtual size_t id() const
+    { return 0x52435053; }
+
+    static bool isBlob(const vle::value::Value& value)
+    { return value.isUser() and dynamic_cast < const Blob* >(&value); }
+
+    virtual std::string name() const
+    { return "rcpsp::Blob"; }
+
+    void putBoolean(bool value)
+    { put(value); }
+
+    void putDouble(double value)
+    { put(value); }
+
+    void putInteger(unsigned int value)
+    { put(value); }
+
+    void putString(const std::string& value)
+    {
+        putInteger(value.size());
+        mData.append(value);
+    }
+
+    unsigned int size() const
+    { return mData.size(); }
+
+    static const Blob& toBlob(const vle::value::Value& value)
+    { return dynamic_cast < const Blob& >(value); }
+
+    virtual void writeFile(std::ostream& out) const;
+
+    virtual void writeString(std::ostream& out) const;
+
+    virtual void writeXml(std::ostream& out) const;
+
+private:
+    template < typename T >
+    void put(const T& value)
+    { mData.append(reinterpret_cast < const char* >(&value), sizeof(T)); }
+
+    std::string mData;
+};
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * @file CriticalPath.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <data/CriticalPath.hpp>
+
+#include <vle/value/Boolean.hpp>
+
+#include <algorithm>
+
+namespace rcpsp {
+
+CriticalPath::CriticalPath(const PrecedencesGraph& graph,
+                           const std::vector < vle::devs::Time >& durations) :
+    mConstraints(graph.constraints()), mDurations(durations)
+{
+    init(graph.size());
+}
+
+CriticalPath::CriticalPath(const PrecedencesGraph& graph,
+                           const Activities& activities) :
+    mConstraints(graph.constraints())
+{
+    for (Activities::const_iterator it = activities.begin();
+         it != activities.end(); ++it) {
+        const TemporalConstraints& tc = (*it)->temporalConstraints();
+
+        mDurations.push_back((*it)->duration());
+        mReleases.push_back(tc.isES() ? tc.earlyStartTime() : 0);
+    }
+    init(graph.size());
+}
+
+void CriticalPath::apply(Activities& activities) const
+{
+    for (unsigned int i = 0; i < size() and i < activities.size(); ++i) {
+        const TemporalConstraints& tc = activities[i]->temporalConstraints();
+
+        activities[i]->temporalConstraints(
+            TemporalConstraints(
+                (TemporalConstraints::Type)(tc.type() |
+                                            TemporalConstraints::LF),
+                tc.isES() ? tc.earlyStartTime() : earlyStartTime(i),
+                tc.isLS() ? tc.lateStartTime() : lateStartTime(i),
+                tc.isEF() ? tc.earlyFinishTime() : earlyFinishTime(i),
+                tc.isLF() ? tc.lateFinishTime() : lateFinishTime(i)));
+    }
+}
+
+void CriticalPath::backward(unsigned int position)
+{
+    for (unsigned int p = position + 1; p > 0; --p) {
+        unsigned int index = mOrder[p - 1];
+
+        if (mDirty[index]) {
+            vle::devs::Time start = latest(index);
+
+            mDirty[index] = false;
+            if (start != mLateStartTimes[index]) {
+                mLateStartTimes[index] = start;
+                touch(mPredecessors[index], true);
+            }
+        }
+    }
+}
+
+void CriticalPath::configure(const vle::value::Map& events,
+                             const PrecedencesGraph& graph,
+                             Activities& activities)
+{
+    if (events.exist("critical path") and
+        vle::value::toBoolean(events.get("critical path"))) {
+        CriticalPath(graph, activities).apply(activities);
+    }
+}
+
+void CriticalPath::duration(unsigned int index, const vle::devs::Time& duration)
+{
+    // the time lags of the arcs of the activity depend on its duration
+    move(index, mEarlyStartTimes[index], duration);
+    mDirty[index] = true;
+    touch(mSuccessors[index], false);
+    forward(mPositions[index]);
+    if (update()) {
+        mDirty.assign(size(), true);
+        backward(size() - 1);
+    } else {
+        mDirty[index] = true;
+        touch(mPredecessors[index], true);
+        backward(mPositions[index]);
+    }
+}
+
+vle::devs::Time CriticalPath::earliest(unsigned int index) const
+{
+    const std::vector < unsigned int >& arcs = mPredecessors[index];
+    vle::devs::Time start = mReleases[index];
+
+    for (std::vector < unsigned int >::const_iterator it = arcs.begin();
+         it != arcs.end(); ++it) {
+        const PrecedenceConstraint& c = mConstraints[*it];
+
+        start = std::max(start, mEarlyStartTimes[c.first()] + lag(c));
+    }
+    return start;
+}
+
+void CriticalPath::forward(unsigned int position)
+{
+    for (unsigned int p = position; p < mOrder.size(); ++p) {
+        unsigned int index = mOrder[p];
+
+        if (mDirty[index]) {
+            vle::devs::Time start = earliest(index);
+
+            mDirty[index] = false;
+            if (start != mEarlyStartTimes[index]) {
+                move(index, start, mDurations[index]);
+                touch(mSuccessors[index], false);
+            }
+        }
+    }
+}
+
+vle::devs::Time CriticalPath::freeSlack(unsigned int index) const
+{
+    const std::vector < unsigned int >& arcs = mSuccessors[index];
+    vle::devs::Time slack = mMakespan - earlyFinishTime(index);
+
+    for (std::vector < unsigned int >::const_iterator it = arcs.begin();
+         it != arcs.end(); ++it) {
+        const PrecedenceConstraint& c = mConstraints[*it];
+
+        slack = std::min(slack, mEarlyStartTimes[c.second()] - lag(c) -
+                         mEarlyStartTimes[index]);
+    }
+    return slack;
+}
+
+void CriticalPath::init(unsigned int size)
+{
+    if (size > mDurations.size()) {
+        mDurations.resize(size, 0);
+    }
+    mReleases.resize(mDurations.size(), 0);
+    mPredecessors.resize(mDurations.size());
+    mSuccessors.resize(mDurations.size());
+    for (unsigned int i = 0; i < mConstraints.size(); ++i) {
+        mSuccessors[mConstraints[i].first()].push_back(i);
+        mPredecessors[mConstraints[i].second()].push_back(i);
+    }
+    sort();
+    mEarlyStartTimes = mReleases;
+    mFinishTimes.clear();
+    for (unsigned int i = 0; i < mDurations.size(); ++i) {
+        mFinishTimes.insert(earlyFinishTime(i));
+    }
+    mLateStartTimes.assign(mDurations.size(), 0);
+    mDirty.assign(mDurations.size(), true);
+    mMakespan = 0;
+    forward(0);
+    update();
+    if (not mOrder.empty()) {
+        mDirty.assign(mDurations.size(), true);
+        backward(mOrder.size() - 1);
+    }
+}
+
+vle::devs::Time CriticalPath::latest(unsigned int index) const
+{
+    const std::vector < unsigned int >& arcs = mSuccessors[index];
+    vle::devs::Time start = mMakespan - mDurations[index];
+
+    for (std::vector < unsigned int >::const_iterator it = arcs.begin();
+         it != arcs.end(); ++it) {
+        const PrecedenceConstraint& c = mConstraints[*it];
+
+        start = std::min(start, mLateStartTimes[c.second()] - lag(c));
+    }
+    return start;
+}
+
+vle::devs::Time CriticalPath::lag(const PrecedenceConstraint& c) const
+{
+    // the minimal distance between the starts of the two activities
+    vle::devs::Time lag = c.minTimelag();
+
+    if (c.isFS() or c.isFF()) {
+        lag += mDurations[c.first()];
+    }
+    if (c.isSF() or c.isFF()) {
+        lag -= mDurations[c.second()];
+    }
+    return lag;
+}
+
+void CriticalPath::move(unsigned int index, const vle::devs::Time& start,
+                        const vle::devs::Time& duration)
+{
+    mFinishTimes.erase(mFinishTimes.find(earlyFinishTime(index)));
+    mEarlyStartTimes[index] = start;
+    mDurations[index] = duration;
+    mFinishTimes.insert(earlyFinishTime(index));
+}
+
+void CriticalPath::sort()
+{
+    std::vector < unsigned int > counters(size(), 0);
+
+    for (PrecedenceConstraints::const_iterator it = mConstraints.begin();
+         it != mConstraints.end(); ++it) {
+        ++counters[it->second()];
+    }
+    mOrder.clear();
+    for (unsigned int i = 0; i < size(); ++i) {
+        if (counters[i] == 0) {
+            mOrder.push_back(i);
+        }
+    }
+    for (unsigned int p = 0; p < mOrder.size(); ++p) {
+        const std::vector < unsigned int >& arcs = mSuccessors[mOrder[p]];
+
+        for (std::vector < unsigned int >::const_iterator it = arcs.begin();
+             it != arcs.end(); ++it) {
+            if (--counters[mConstraints[*it].second()] == 0) {
+                mOrder.push_back(mConstraints[*it].second());
+            }
+        }
+    }
+    if (mOrder.size() != size()) {
+        throw vle::utils::ModellingError("cycle in the precedences graph");
+    }
+    mPositions.resize(size());
+    for (unsigned int p = 0; p < mOrder.size(); ++p) {
+        mPositions[mOrder[p]] = p;
+    }
+}
+
+void CriticalPath::touch(const std::vector < unsigned int >& arcs, bool first)
+{
+    for (std::vector < unsigned int >::const_iterator it = arcs.begin();
+         it != arcs.end(); ++it) {
+        mDirty[first ? mConstraints[*it].first() :
+               mConstraints[*it].second()] = true;
+    }
+}
+
+bool CriticalPath::update()
+{
+    vle::devs::Time makespan = mFinishTimes.empty() ? 0 :
+        std::max(0., *mFinishTimes.rbegin());
+
+    if (makespan != mMakespan) {
+        mMakespan = makespan;
+        return true;
+    }
+    return false;
+}
+
+} // namespace rcpsp
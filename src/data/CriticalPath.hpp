@@ -0,0 +1,147 @@
+/**
+ * @file CriticalPath.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __CRITICAL_PATH_HPP
+#define __CRITICAL_PATH_HPP 1
+
+#include <vle/value/Map.hpp>
+
+#include <data/PrecedencesGraph.hpp>
+
+#include <set>
+
+namespace rcpsp {
+
+/**
+ * The critical path method over a precedences graph: the forward pass
+ * computes the early start times, the backward pass the late start times
+ * for the makespan, both in topological order so that each arc is visited
+ * once. All the relation types are taken into account with their minimal
+ * time lag; an activity starts at the earliest at its entered early start
+ * time, at 0 otherwise.
+ *
+ * When the duration of an activity changes, only the activities reached
+ * from it are recomputed and the makespan is kept from the sorted early
+ * finish times. The graph must outlive the critical path.
+ */
+class CriticalPath
+{
+public:
+    CriticalPath(const PrecedencesGraph& graph,
+                 const std::vector < vle::devs::Time >& durations);
+
+    CriticalPath(const PrecedencesGraph& graph,
+                 const Activities& activities);
+
+    /**
+     * Fill the unset times of the temporal constraints of the activities
+     * with the computed ones, the entered ones being kept, and bound their
+     * late finish time.
+     */
+    void apply(Activities& activities) const;
+
+    /**
+     * Apply the critical path of the graph to the activities when the
+     * "critical path" port of the condition is true.
+     */
+    static void configure(const vle::value::Map& events,
+                          const PrecedencesGraph& graph,
+                          Activities& activities);
+
+    bool critical(unsigned int index) const
+    { return totalSlack(index) <= 0; }
+
+    const vle::devs::Time& duration(unsigned int index) const
+    { return mDurations[index]; }
+
+    void duration(unsigned int index, const vle::devs::Time& duration);
+
+    vle::devs::Time earlyFinishTime(unsigned int index) const
+    { return mEarlyStartTimes[index] + mDurations[index]; }
+
+    const vle::devs::Time& earlyStartTime(unsigned int index) const
+    { return mEarlyStartTimes[index]; }
+
+    /**
+     * The delay of the activity which does not delay the early start of
+     * its successors.
+     */
+    vle::devs::Time freeSlack(unsigned int index) const;
+
+    vle::devs::Time lateFinishTime(unsigned int index) const
+    { return mLateStartTimes[index] + mDurations[index]; }
+
+    const vle::devs::Time& lateStartTime(unsigned int index) const
+    { return mLateStartTimes[index]; }
+
+    const vle::devs::Time& makespan() const
+    { return mMakespan; }
+
+    unsigned int size() const
+    { return mDurations.size(); }
+
+    TemporalConstraints temporalConstraints(
+        unsigned int index, TemporalConstraints::Type type) const
+    {
+        return TemporalConstraints(type, earlyStartTime(index),
+                                   lateStartTime(index),
+                                   earlyFinishTime(index),
+                                   lateFinishTime(index));
+    }
+
+    vle::devs::Time totalSlack(unsigned int index) const
+    { return mLateStartTimes[index] - mEarlyStartTimes[index]; }
+
+private:
+    typedef std::vector < std::vector < unsigned int > > arcs_t;
+
+    void backward(unsigned int position);
+    vle::devs::Time earliest(unsigned int index) const;
+    void forward(unsigned int position);
+    void init(unsigned int size);
+    vle::devs::Time latest(unsigned int index) const;
+    vle::devs::Time lag(const PrecedenceConstraint& c) const;
+    void move(unsigned int index, const vle::devs::Time& start,
+              const vle::devs::Time& duration);
+    void sort();
+    bool update();
+    void touch(const std::vector < unsigned int >& arcs, bool first);
+
+    const PrecedenceConstraints& mConstraints;
+    arcs_t mPredecessors;
+    arcs_t mSuccessors;
+    std::vector < unsigned int > mOrder;
+    std::vector < unsigned int > mPositions;
+    std::vector < vle::devs::Time > mDurations;
+    std::vector < vle::devs::Time > mReleases;
+    std::vector < vle::devs::Time > mEarlyStartTimes;
+    std::multiset < vle::devs::Time > mFinishTimes;
+    std::vector < vle::devs::Time > mLateStartTimes;
+    std::vector < bool > mDirty;
+    vle::devs::Time mMakespan;
+};
+
+} // namespace rcpsp
+
+#endif
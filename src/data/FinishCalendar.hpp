@@ -0,0 +1,112 @@
+/**
+ * @file FinishCalendar.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FINISH_CALENDAR_HPP
+#define __FINISH_CALENDAR_HPP 1
+
+#include <data/Activities.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace rcpsp {
+
+/**
+ * The finish dates of the steps running on a processor. The running
+ * activities are kept in the given list, where a finished activity is
+ * replaced by the last one.
+ */
+class FinishCalendar
+{
+public:
+    FinishCalendar(Activities& running) : mRunningActivities(running)
+    { }
+
+    virtual ~FinishCalendar()
+    { }
+
+    bool empty() const
+    { return mFinishDates.empty(); }
+
+    /**
+     * Move the activities whose step is done at the time to the done
+     * ones: the activities finishing at the same date leave in one batch.
+     */
+    void finish(const vle::devs::Time& time, Activities& done)
+    {
+        while (not mFinishDates.empty() and
+               mFinishDates.begin()->second->done(time)) {
+            Activity* a = mFinishDates.begin()->second;
+
+            mFinishDates.erase(mFinishDates.begin());
+            a->finish(time);
+            done.push_back(a);
+            remove(a);
+        }
+    }
+
+    /** The duration until the next finish date, infinity if none. */
+    vle::devs::Time next(const vle::devs::Time& time) const
+    {
+        if (mFinishDates.empty()) {
+            return vle::devs::infinity;
+        }
+        return std::max(0., mFinishDates.begin()->first - time);
+    }
+
+    /** Start the current step of the activity at the time. */
+    void start(const vle::devs::Time& time, Activity* a)
+    {
+        a->start(time);
+        mPositions[a] = mRunningActivities.size();
+        mRunningActivities.push_back(a);
+        mFinishDates.insert(
+            std::make_pair(time + a->remainingTime(time), a));
+    }
+
+private:
+    FinishCalendar(const FinishCalendar&);
+    FinishCalendar& operator=(const FinishCalendar&);
+
+    typedef std::multimap < vle::devs::Time, Activity* > Dates;
+    typedef std::map < const Activity*, unsigned int > Positions;
+
+    void remove(Activity* a)
+    {
+        Positions::iterator it = mPositions.find(a);
+        Activity* last = mRunningActivities.back();
+
+        mRunningActivities[it->second] = last;
+        mPositions[last] = it->second;
+        mPositions.erase(it);
+        mRunningActivities.pop_back();
+    }
+
+    Activities& mRunningActivities;
+    Dates mFinishDates;
+    Positions mPositions;
+};
+
+} // namespace rcpsp
+
+#endif
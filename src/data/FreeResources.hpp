@@ -0,0 +1,102 @@
+/**
+ * @file FreeResources.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __FREE_RESOURCES_HPP
+#define __FREE_RESOURCES_HPP 1
+
+#include <data/ResourceConstraints.hpp>
+
+#include <map>
+
+namespace rcpsp {
+
+/**
+ * The free quantity of the types a demand was refused, learnt from the
+ * answer of the pools and kept up to date with the resources assigned and
+ * released since. The quantity of a type never refused is unknown and
+ * does not limit a demand.
+ */
+class FreeResources
+{
+public:
+    FreeResources()
+    { }
+
+    /** Count the resources assigned to a demand. */
+    void assigned(const Resources& r)
+    {
+        for (Resources::const_iterator it = r.begin(); it != r.end(); ++it) {
+            quantities_t::iterator itf = mQuantities.find(
+                Resources::resource(*it).type());
+
+            if (itf != mQuantities.end() and itf->second > 0) {
+                --itf->second;
+            }
+        }
+    }
+
+    /** Learn the free quantities from the missing ones of a demand. */
+    void refused(const ResourceDemand& requested,
+                 const ResourceTypes& missing)
+    {
+        for (unsigned int type = 0; type < missing.size(); ++type) {
+            if (missing[type] > 0) {
+                mQuantities[type] = requested.quantity(type) - missing[type];
+            }
+        }
+    }
+
+    /** Count the resources published as released by the pools. */
+    void released(const ResourceTypes& released)
+    {
+        for (quantities_t::iterator it = mQuantities.begin();
+             it != mQuantities.end(); ++it) {
+            it->second += released[it->first];
+        }
+    }
+
+    /** Whether no known quantity is short for the demand. */
+    bool satisfiable(const ResourceDemand& demand) const
+    {
+        for (ResourceDemand::types_t::const_iterator it =
+                 demand.types().begin(); it != demand.types().end(); ++it) {
+            quantities_t::const_iterator itf = mQuantities.find(*it);
+
+            if (itf != mQuantities.end() and
+                itf->second < demand.quantity(*it)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    typedef std::map < unsigned int, unsigned int > quantities_t;
+
+    quantities_t mQuantities;
+};
+
+} // namespace rcpsp
+
+#endif
@@ -31,28 +31,51 @@
 #include <vle/value/String.hpp>
 #include <vle/value/Value.hpp>
 
+#include <data/Blob.hpp>
+#include <data/Symbols.hpp>
+
 namespace rcpsp {
 
 class Location
 {
 public:
-    Location(const std::string& name = "") : mName(name)
+    Location(const std::string& name = "") :
+        mName(name), mId(Symbols::locations().id(name))
     { }
 
     Location(const vle::value::Value* value)
-    { mName = vle::value::toString(value); }
+    {
+        mName = vle::value::toString(value);
+        mId = Symbols::locations().id(mName);
+    }
+
+    Location(Blob::Reader& reader) : mId(reader.getInteger())
+    { mName = Symbols::locations().name(mId); }
 
     static const std::string& get(const vle::devs::ExternalEvent* ee)
     { return ee->getStringAttributeValue("location"); }
 
+    unsigned int id() const
+    { return mId; }
+
     const std::string& name() const
     { return mName; }
 
+    bool operator==(const Location& location) const
+    { return mId == location.mId; }
+
+    bool operator!=(const Location& location) const
+    { return mId != location.mId; }
+
     vle::value::Value* toValue() const
     { return new vle::value::String(mName); }
 
+    void write(Blob& blob) const
+    { blob.putInteger(mId); }
+
 private:
     std::string mName;
+    unsigned int mId;
 };
 
 typedef std::vector < Location > Path;
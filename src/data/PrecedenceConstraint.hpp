@@ -25,10 +25,10 @@
 #define __PRECEDENCE_CONTRAINTS_HPP 1
 
 #include <string>
+#include <vector>
 
 #include <vle/devs/Time.hpp>
-
-#include <data/Activities.hpp>
+#include <vle/utils/Exception.hpp>
 
 namespace rcpsp {
 
@@ -42,8 +42,8 @@ public:
         FF /**< Finish to Finish relationship. */
     };
 
-    PrecedenceConstraint(Activities::const_iterator& first,
-                         Activities::const_iterator& second,
+    PrecedenceConstraint(unsigned int first,
+                         unsigned int second,
                          Type type,
                          const vle::devs::Time& mintimelag,
                          const vle::devs::Time& maxtimelag) :
@@ -51,6 +51,11 @@ public:
         mMinTimelag(mintimelag), mMaxTimelag(maxtimelag)
     { }
 
+    /** The index of the predecessor in the activities of the graph. */
+    unsigned int first() const { return mFirst; }
+    /** The index of the successor in the activities of the graph. */
+    unsigned int second() const { return mSecond; }
+
     bool isSS() const { return mType == SS; }
     bool isFS() const { return mType == FS; }
     bool isSF() const { return mType == SF; }
@@ -61,9 +66,29 @@ public:
     const vle::devs::Time& minTimelag() const { return mMinTimelag; }
     const vle::devs::Time& maxTimelag() const { return mMaxTimelag; }
 
+    /**
+     * A constraint is satisfied by the start of its predecessor (SS, SF)
+     * or by its completion (FS, FF).
+     */
+    bool onStart() const { return mType == SS or mType == SF; }
+
+    static Type type(const std::string& name)
+    {
+        if (name == "SS") {
+            return SS;
+        } else if (name == "SF") {
+            return SF;
+        } else if (name == "FS") {
+            return FS;
+        } else if (name == "FF") {
+            return FF;
+        }
+        throw vle::utils::ModellingError("unknown precedence type: " + name);
+    }
+
 private:
-    Activities::const_iterator mFirst;
-    Activities::const_iterator mSecond;
+    unsigned int mFirst;
+    unsigned int mSecond;
     Type mType;
     vle::devs::Time mMinTimelag;
     vle::devs::Time mMaxTimelag;
@@ -0,0 +1,165 @@
+/**
+ * @file PrecedencesGraph.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <data/PrecedencesGraph.hpp>
+
+#include <algorithm>
+
+namespace rcpsp {
+
+PrecedencesGraph::PrecedencesGraph(const vle::value::Value* value,
+                                   const Activities& activities)
+{
+    resize(activities.size());
+    for (unsigned int i = 0; i < activities.size(); ++i) {
+        mIndexes[activities[i]->name()] = i;
+        mDurations[i] = activities[i]->duration();
+    }
+
+    const vle::value::Set* set = dynamic_cast < const vle::value::Set* >(value);
+
+    for (unsigned int i = 0; i < set->size(); ++i) {
+        const vle::value::Set* precedence =
+            dynamic_cast < const vle::value::Set* >(set->get(i));
+        unsigned int first = index(vle::value::toString(precedence->get(0)));
+        unsigned int second = index(vle::value::toString(precedence->get(1)));
+
+        if (first == size() or second == size()) {
+            throw vle::utils::ModellingError(
+                "unknown activity in precedence: " +
+                vle::value::toString(precedence->get(first == size() ? 0 : 1)));
+        }
+        // the scheduler only delays the successors: a maximal time lag
+        // would be silently violated
+        if (precedence->size() > 4 and
+            vle::value::toDouble(precedence->get(4)) != vle::devs::infinity) {
+            throw vle::utils::ModellingError(
+                "maximal time lag not supported in precedence: " +
+                vle::value::toString(precedence->get(0)) + " -> " +
+                vle::value::toString(precedence->get(1)));
+        }
+        add(first, second,
+            PrecedenceConstraint::type(
+                vle::value::toString(precedence->get(2))),
+            precedence->size() > 3 ?
+            vle::value::toDouble(precedence->get(3)) : 0,
+            vle::devs::infinity);
+    }
+}
+
+void PrecedencesGraph::add(unsigned int first,
+                           unsigned int second,
+                           PrecedenceConstraint::Type type,
+                           const vle::devs::Time& mintimelag,
+                           const vle::devs::Time& maxtimelag)
+{
+    resize(std::max(first, second) + 1);
+    mSuccessors[first].push_back(mPrecedenceContraints.size());
+    ++mCounters[second];
+    mPrecedenceContraints.push_back(
+        PrecedenceConstraint(first, second, type, mintimelag, maxtimelag));
+}
+
+unsigned int PrecedencesGraph::index(const std::string& name) const
+{
+    indexes_t::const_iterator it = mIndexes.find(name);
+
+    return it == mIndexes.end() ? size() : it->second;
+}
+
+void PrecedencesGraph::rank(Activities& activities) const
+{
+    // the activity of the last visit of each node
+    std::vector < unsigned int > visited(size(), size());
+    std::vector < unsigned int > stack;
+
+    for (unsigned int i = 0; i < size() and i < activities.size(); ++i) {
+        unsigned int number = 0;
+        vle::devs::Time work = 0;
+
+        stack.push_back(i);
+        visited[i] = i;
+        while (not stack.empty()) {
+            const std::vector < unsigned int >& successors =
+                mSuccessors[stack.back()];
+
+            stack.pop_back();
+            for (std::vector < unsigned int >::const_iterator it =
+                     successors.begin(); it != successors.end(); ++it) {
+                unsigned int second = mPrecedenceContraints[*it].second();
+
+                if (visited[second] != i) {
+                    visited[second] = i;
+                    ++number;
+                    work += mDurations[second];
+                    stack.push_back(second);
+                }
+            }
+        }
+        activities[i]->successors(number, work);
+    }
+}
+
+void PrecedencesGraph::resize(unsigned int size)
+{
+    if (size > mCounters.size()) {
+        mSuccessors.resize(size);
+        mCounters.resize(size, 0);
+        mReleases.resize(size, -vle::devs::infinity);
+        mDurations.resize(size, 0);
+    }
+}
+
+void PrecedencesGraph::satisfy(unsigned int index, bool start,
+                               const vle::devs::Time& time, result_t& ready)
+{
+    if (index >= size()) {
+        return;
+    }
+
+    const std::vector < unsigned int >& successors = mSuccessors[index];
+
+    for (std::vector < unsigned int >::const_iterator it = successors.begin();
+         it != successors.end(); ++it) {
+        const PrecedenceConstraint& constraint = mPrecedenceContraints[*it];
+
+        if (constraint.onStart() == start) {
+            unsigned int second = constraint.second();
+            vle::devs::Time release = time + constraint.minTimelag();
+
+            // SF and FF bound the finish of the successor
+            if (constraint.isSF() or constraint.isFF()) {
+                release -= mDurations[second];
+            }
+            if (mReleases[second] < release) {
+                mReleases[second] = release;
+            }
+            if (--mCounters[second] == 0) {
+                ready.push_back(second);
+            }
+        }
+    }
+}
+
+} // namespace rcpsp
@@ -21,31 +21,99 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef __PRECEDENCE_GRAPH_HPP
 #define __PRECEDENCE_GRAPH_HPP 1
 
+#include <map>
+
+#include <vle/value/Value.hpp>
+
+#include <data/Activities.hpp>
 #include <data/PrecedenceConstraint.hpp>
 
 namespace rcpsp {
 
+/**
+ * The precedence network of the activities, indexed by the position of
+ * the activities in the "activities" condition.
+ *
+ * Each activity counts its unsatisfied incoming constraints: the start or
+ * the completion of an activity only visits its outgoing constraints and
+ * reports the successors which become ready.
+ */
 class PrecedencesGraph
 {
 public:
+    typedef std::vector < unsigned int > result_t;
+
     PrecedencesGraph()
     { }
 
-    void add(Activities::const_iterator& first,
-             Activities::const_iterator& second,
+    /**
+     * Build the graph from a set of [first, second, type, min lag, max lag]
+     * where the activities are given by their name and the lags are
+     * optional. A finite max lag is rejected.
+     */
+    PrecedencesGraph(const vle::value::Value* value,
+                     const Activities& activities);
+
+    void add(unsigned int first,
+             unsigned int second,
              PrecedenceConstraint::Type type,
              const vle::devs::Time& mintimelag,
-             const vle::devs::Time& maxtimelag)
-    {
-        mPrecedenceContraints.push_back(
-            PrecedenceConstraint(first, second, type, mintimelag, maxtimelag));
-    }
+             const vle::devs::Time& maxtimelag);
+
+    const PrecedenceConstraints& constraints() const
+    { return mPrecedenceContraints; }
+
+    bool empty() const
+    { return mPrecedenceContraints.empty(); }
+
+    /** The index of the named activity, or size() if unknown. */
+    unsigned int index(const std::string& name) const;
+
+    /**
+     * Give each activity the number of the activities which follow it,
+     * directly or not, and the total duration of their steps.
+     */
+    void rank(Activities& activities) const;
+
+    bool ready(unsigned int index) const
+    { return mCounters[index] == 0; }
+
+    /** The earliest start allowed by the time lags of the satisfied
+        constraints. The successor of a SF or FF constraint may start the
+        duration of its work before the lag. */
+    const vle::devs::Time& release(unsigned int index) const
+    { return mReleases[index]; }
+
+    unsigned int size() const
+    { return mCounters.size(); }
+
+    /** The activity is dispatched at the time, which stands for the start
+        of its first step. */
+    void started(unsigned int index, const vle::devs::Time& time,
+                 result_t& ready)
+    { satisfy(index, true, time, ready); }
+
+    void finished(unsigned int index, const vle::devs::Time& time,
+                  result_t& ready)
+    { satisfy(index, false, time, ready); }
 
 private:
+    typedef std::map < std::string, unsigned int > indexes_t;
+
+    void resize(unsigned int size);
+    void satisfy(unsigned int index, bool start, const vle::devs::Time& time,
+                 result_t& ready);
+
     PrecedenceConstraints mPrecedenceContraints;
+    std::vector < std::vector < unsigned int > > mSuccessors;
+    std::vector < unsigned int > mCounters;
+    std::vector < vle::devs::Time > mReleases;
+    std::vector < vle::devs::Time > mDurations;
+    indexes_t mIndexes;
 };
 
 } // namespace rcpsp
@@ -0,0 +1,87 @@
+/**
+ * @file ReleaseCalendar.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <data/ReleaseCalendar.hpp>
+#include <data/Time.hpp>
+
+#include <algorithm>
+
+namespace rcpsp {
+
+ReleaseCalendar::~ReleaseCalendar()
+{
+    for (std::vector < Entry >::iterator it = mCalendar.begin();
+         it != mCalendar.end(); ++it) {
+        delete it->activity;
+    }
+}
+
+vle::devs::Time ReleaseCalendar::next(const vle::devs::Time& time) const
+{
+    if (mCalendar.empty()) {
+        return vle::devs::infinity;
+    }
+    return std::max(0., mCalendar.front().time - time);
+}
+
+void ReleaseCalendar::push(Activity* activity, const vle::devs::Time& time)
+{
+    vle::devs::Time release = time;
+    const TemporalConstraints& tc = activity->temporalConstraints();
+
+    if (tc.isES() or tc.isLS()) {
+        release = std::max(release, tc.earlyStartTime());
+    }
+    if (not activity->steps().empty()) {
+        const TemporalConstraints& stc =
+            activity->steps().front()->temporalConstraints();
+
+        if (stc.isES() or stc.isLS()) {
+            release = std::max(release, stc.earlyStartTime());
+        }
+    }
+    mCalendar.push_back(Entry(release, mSequence++, activity));
+    std::push_heap(mCalendar.begin(), mCalendar.end());
+}
+
+void ReleaseCalendar::starting(const vle::devs::Time& time)
+{
+    while (not mCalendar.empty() and reached(mCalendar.front().time, time)) {
+        Activity* activity = mCalendar.front().activity;
+
+        std::pop_heap(mCalendar.begin(), mCalendar.end());
+        mCalendar.pop_back();
+        if (activity->steps().empty()) {
+            mExpiredActivities.push_back(activity);
+        } else {
+            if (not activity->starting(time)) {
+                mLateActivities.push_back(activity);
+            }
+            activity->wait(time);
+            mStartingActivities.push_back(activity);
+        }
+    }
+}
+
+} // namespace rcpsp
@@ -0,0 +1,111 @@
+/**
+ * @file ReleaseCalendar.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __RELEASE_CALENDAR_HPP
+#define __RELEASE_CALENDAR_HPP 1
+
+#include <data/Activities.hpp>
+
+namespace rcpsp {
+
+/**
+ * The activities waiting for their release, in a min-heap ordered by the
+ * earliest date they may start then by arrival. A wake-up only pops the
+ * activities released at that date and hands them over to the caller. The
+ * ones whose start window is already closed start late and are flagged;
+ * the ones without step cannot start and are kept aside. The calendar owns
+ * the pending activities.
+ */
+class ReleaseCalendar
+{
+public:
+    ReleaseCalendar() : mSequence(0)
+    { }
+
+    virtual ~ReleaseCalendar();
+
+    bool empty() const
+    { return mCalendar.empty(); }
+
+    /** The duration until the next release, 0 if one is due. */
+    vle::devs::Time next(const vle::devs::Time& time) const;
+
+    /**
+     * Add an activity, released at the given date or at the early start
+     * time of its temporal constraints and of its first step if later.
+     */
+    void push(Activity* activity,
+              const vle::devs::Time& time = vle::devs::negativeInfinity);
+
+    /** The activities handed over after the close of their window. */
+    const Activities::result_t& lateActivities() const
+    { return mLateActivities; }
+
+    /** Forget the activities handed over by the last call to starting. */
+    void removeStartingActivities()
+    {
+        mStartingActivities.clear();
+        mLateActivities.clear();
+    }
+
+    unsigned int size() const
+    { return mCalendar.size(); }
+
+    void starting(const vle::devs::Time& time);
+
+    const Activities::result_t& startingActivities() const
+    { return mStartingActivities; }
+
+private:
+    ReleaseCalendar(const ReleaseCalendar&);
+    ReleaseCalendar& operator=(const ReleaseCalendar&);
+
+    struct Entry
+    {
+        Entry(const vle::devs::Time& time, unsigned long sequence,
+              Activity* activity) :
+            time(time), sequence(sequence), activity(activity)
+        { }
+
+        bool operator<(const Entry& e) const
+        {
+            // the heap keeps the greatest entry on top
+            return time > e.time or (time == e.time and sequence > e.sequence);
+        }
+
+        vle::devs::Time time;
+        unsigned long sequence;
+        Activity* activity;
+    };
+
+    std::vector < Entry > mCalendar;
+    Activities::result_t mStartingActivities;
+    Activities::result_t mLateActivities;
+    Activities mExpiredActivities;
+    unsigned long mSequence;
+};
+
+} // namespace rcpsp
+
+#endif
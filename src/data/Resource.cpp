@@ -27,7 +27,7 @@ namespace rcpsp {
 
 std::ostream& operator<<(std::ostream& o, const Resource& r)
 {
-    o << "[ " << r.mName << " , " << r.mType << " ]";
+    o << "[ " << r.mName << " , " << r.typeName() << " ]";
     return o;
 }
 
@@ -31,6 +31,7 @@
 #include <vle/value/Value.hpp>
 
 #include <data/Planning.hpp>
+#include <data/Symbols.hpp>
 
 namespace rcpsp {
 
@@ -38,7 +39,7 @@ class Resource
 {
 public:
     Resource(const std::string& name, const std::string& type) :
-        mName(name), mType(type)
+        mName(name), mType(Symbols::resourceTypes().id(type))
     { }
 
     Resource(const vle::value::Value* value)
@@ -47,7 +48,8 @@ public:
             dynamic_cast < const vle::value::Set* >(value);
 
         mName = vle::value::toString(set->get(0));
-        mType = vle::value::toString(set->get(1));
+        mType = Symbols::resourceTypes().id(
+            vle::value::toString(set->get(1)));
     }
 
     const std::string& name() const
@@ -58,18 +60,21 @@ public:
         vle::value::Set* value = new vle::value::Set;
 
         value->add(new vle::value::String(mName));
-        value->add(new vle::value::String(mType));
+        value->add(new vle::value::String(typeName()));
         return value;
     }
 
-    const std::string& type() const
+    unsigned int type() const
     { return mType; }
 
+    const std::string& typeName() const
+    { return Symbols::resourceTypes().name(mType); }
+
 private:
     friend std::ostream& operator<<(std::ostream& o, const Resource& r);
 
     std::string mName;
-    std::string mType;
+    unsigned int mType;
 };
 
 std::ostream& operator<<(std::ostream& o, const Resource& r);
@@ -0,0 +1,73 @@
+/**
+ * @file ResourceBank.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <data/ResourceBank.hpp>
+
+namespace rcpsp {
+
+ResourceBank::ResourceBank(const vle::value::Value* value)
+{
+    const vle::value::Set* set = dynamic_cast < const vle::value::Set* >(value);
+
+    for (unsigned int i = 0; i < set->size(); ++i) {
+        add(ResourcePool(set->get(i)).available());
+    }
+}
+
+void ResourceBank::add(const Resources& r)
+{
+    for (Resources::const_iterator it = r.begin(); it != r.end(); ++it) {
+        if (not mResources.contains(*it)) {
+            ++mQuantities[Resources::resource(*it).type()];
+        }
+    }
+    mResources.add(r);
+}
+
+bool ResourceBank::reserve(const ResourceDemand& demand, Resources& granted,
+                           ResourceTypes& missing)
+{
+    bool available = true;
+
+    for (ResourceDemand::types_t::const_iterator it = demand.types().begin();
+         it != demand.types().end(); ++it) {
+        if (quantity(*it) < demand.quantity(*it)) {
+            missing[*it] = demand.quantity(*it) - quantity(*it);
+            available = false;
+        }
+    }
+    if (available) {
+        for (ResourceDemand::types_t::const_iterator it =
+                 demand.types().begin(); it != demand.types().end(); ++it) {
+            Resources r = mResources.ofType(*it).first(demand.quantity(*it));
+
+            mResources.remove(r);
+            mQuantities[*it] -= demand.quantity(*it);
+            granted.add(r);
+        }
+    }
+    return available;
+}
+
+} // namespace rcpsp
@@ -0,0 +1,78 @@
+/**
+ * @file ResourceBank.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __RESOURCE_BANK_HPP
+#define __RESOURCE_BANK_HPP 1
+
+#include <data/ResourceConstraints.hpp>
+#include <data/ResourcePool.hpp>
+
+namespace rcpsp {
+
+/**
+ * The free resources of all the pools of a location, with the number of
+ * free resources indexed by type. A demand is reserved as a whole: either
+ * every type is granted or nothing is taken and the missing quantities
+ * are reported.
+ */
+class ResourceBank
+{
+public:
+    ResourceBank()
+    { }
+
+    /**
+     * Build the bank from a set of pools, each one given as the value of
+     * the pool condition: [name, type, resources]. The pools of a same
+     * type are merged.
+     */
+    ResourceBank(const vle::value::Value* value);
+
+    void add(const Resources& r);
+
+    const Resources& available() const
+    { return mResources; }
+
+    unsigned int quantity(unsigned int type) const
+    { return mQuantities[type]; }
+
+    void release(const Resources& r)
+    { add(r); }
+
+    /**
+     * Take the resources of the demand and add them to granted if all the
+     * types are available, otherwise fill missing with the shortfall of
+     * each type and take nothing.
+     */
+    bool reserve(const ResourceDemand& demand, Resources& granted,
+                 ResourceTypes& missing);
+
+private:
+    Resources mResources;
+    ResourceTypes mQuantities;
+};
+
+} // namespace rcpsp
+
+#endif
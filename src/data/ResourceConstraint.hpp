@@ -28,7 +28,9 @@
 #include <vle/devs/Time.hpp>
 #include <vle/value/Value.hpp>
 
+#include <data/Blob.hpp>
 #include <data/Resource.hpp>
+#include <data/Symbols.hpp>
 
 namespace rcpsp {
 
@@ -36,6 +38,11 @@ class ResourceConstraint
 {
 public:
     ResourceConstraint(const std::string& type, int quantity, bool same) :
+        mType(Symbols::resourceTypes().id(type)), mQuantity(quantity),
+        mSame(same)
+    { }
+
+    ResourceConstraint(unsigned int type, int quantity, bool same) :
         mType(type), mQuantity(quantity), mSame(same)
     { }
 
@@ -44,7 +51,8 @@ public:
         const vle::value::Set* set =
             dynamic_cast < const vle::value::Set* >(value);
 
-        mType = vle::value::toString(set->get(0));
+        mType = Symbols::resourceTypes().id(
+            vle::value::toString(set->get(0)));
         mQuantity = vle::value::toInteger(set->get(1));
         if (set->size() == 3) {
             mSame = vle::value::toBoolean(set->get(2));
@@ -53,6 +61,13 @@ public:
         }
     }
 
+    ResourceConstraint(Blob::Reader& reader)
+    {
+        mType = reader.getInteger();
+        mQuantity = reader.getInteger();
+        mSame = reader.getBoolean();
+    }
+
     ResourceConstraint(const ResourceConstraint& rc) :
         mType(rc.mType),
         mQuantity(rc.mQuantity),
@@ -66,6 +81,7 @@ public:
     {
         mType = rc.mType;
         mQuantity = rc.mQuantity;
+        mSame = rc.mSame;
         return *this;
     }
 
@@ -73,20 +89,30 @@ public:
     {
         vle::value::Set* value = new vle::value::Set;
 
-        value->add(new vle::value::String(mType));
+        value->add(new vle::value::String(typeName()));
         value->add(new vle::value::Integer(mQuantity));
         value->add(new vle::value::Boolean(mSame));
         return value;
     }
 
+    void write(Blob& blob) const
+    {
+        blob.putInteger(mType);
+        blob.putInteger(mQuantity);
+        blob.putBoolean(mSame);
+    }
+
     bool same() const
     { return mSame; }
 
-    const std::string& type() const
+    unsigned int type() const
     { return mType; }
 
+    const std::string& typeName() const
+    { return Symbols::resourceTypes().name(mType); }
+
 private:
-    std::string mType;
+    unsigned int mType;
     unsigned int mQuantity;
     bool mSame;
 };
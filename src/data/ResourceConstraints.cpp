@@ -23,62 +23,117 @@
 
 #include <data/ResourceConstraints.hpp>
 
-#include <map>
-
 namespace rcpsp {
 
-ResourceConstraints ResourceConstraints::buildResourceConstraints(
-    const Resources* r) const
+bool ResourceConstraints::needAgain(unsigned int type) const
 {
-    ResourceConstraints rc;
-    std::map < std::string, int > resourceQuantity;
+    bool yes = false;
 
-    for (const_iterator it = begin(); it != end(); ++it) {
-        resourceQuantity[it->type()] = it->quantity();
+    for (const_iterator it = begin(); it != end() and not yes; ++it) {
+        yes = it->type() == type and it->same();
     }
+    return yes;
+}
 
-    if (r) {
-        for (Resources::const_iterator it = r->begin(); it != r->end(); ++it) {
-            --resourceQuantity[(*it)->type()];
+ResourceDemand::ResourceDemand(const vle::value::Value* value) : mQuantity(0)
+{
+    if (Blob::isBlob(*value)) {
+        Blob::Reader reader(Blob::toBlob(*value));
+        unsigned int n = reader.getInteger();
+
+        for (unsigned int i = 0; i < n; ++i) {
+            unsigned int type = reader.getInteger();
+
+            add(type, reader.getInteger());
         }
+    } else {
+        const vle::value::Set& set = vle::value::toSetValue(*value);
+
+        for (unsigned int i = 0; i < set.size(); ++i) {
+            ResourceConstraint rc(set.get(i));
+
+            add(rc.type(), rc.quantity());
+        }
+    }
+}
+
+void ResourceDemand::add(unsigned int type, unsigned int quantity)
+{
+    if (mQuantities[type] == 0) {
+        mTypes.push_back(type);
     }
+    mQuantities[type] += quantity;
+    mQuantity += quantity;
+}
+
+void ResourceDemand::assign(const Resources& r)
+{
+    for (Resources::const_iterator it = r.begin(); it != r.end(); ++it) {
+        unsigned int type = Resources::resource(*it).type();
 
-    for (std::map < std::string, int >::const_iterator it =
-             resourceQuantity.begin(); it != resourceQuantity.end(); ++it) {
-        if (it->second > 0) {
-            rc.push_back(ResourceConstraint(it->first, it->second, false));
+        if (type < mQuantities.size() and mQuantities[type] > 0) {
+            --mQuantities[type];
+            --mQuantity;
         }
     }
-    return rc;
 }
 
-bool ResourceConstraints::checkResourceConstraint(const Resources& r) const
+void ResourceDemand::clear()
 {
-    bool ok = true;
-    std::map < std::string, int > resourceQuantity;
+    for (types_t::const_iterator it = mTypes.begin(); it != mTypes.end();
+         ++it) {
+        mQuantities[*it] = 0;
+    }
+    mTypes.clear();
+    mQuantity = 0;
+}
 
-    for (const_iterator it = begin(); it != end(); ++it) {
-        resourceQuantity[it->type()] = it->quantity();
+void ResourceDemand::reset(const ResourceConstraints& rc, const Resources* r)
+{
+    clear();
+    for (ResourceConstraints::const_iterator it = rc.begin(); it != rc.end();
+         ++it) {
+        add(it->type(), it->quantity());
     }
-    for (Resources::const_iterator it = r.begin(); it != r.end(); ++it) {
-        --resourceQuantity[(*it)->type()];
+    if (r) {
+        assign(*r);
     }
-    for (std::map < std::string, int >::const_iterator it =
-             resourceQuantity.begin(); it != resourceQuantity.end() and ok;
+}
+
+vle::value::Value* ResourceDemand::toEventValue() const
+{
+    Blob* blob = new Blob;
+    unsigned int n = 0;
+
+    for (types_t::const_iterator it = mTypes.begin(); it != mTypes.end();
          ++it) {
-        ok = it->second == 0;
+        if (mQuantities[*it] > 0) {
+            ++n;
+        }
     }
-    return ok;
+    blob->putInteger(n);
+    for (types_t::const_iterator it = mTypes.begin(); it != mTypes.end();
+         ++it) {
+        if (mQuantities[*it] > 0) {
+            blob->putInteger(*it);
+            blob->putInteger(mQuantities[*it]);
+        }
+    }
+    return blob;
 }
 
-bool ResourceConstraints::needAgain(const std::string& type) const
+vle::value::Value* ResourceDemand::toValue() const
 {
-    bool yes = false;
+    vle::value::Set* value = new vle::value::Set;
 
-    for (const_iterator it = begin(); it != end() and not yes; ++it) {
-        yes = it->type() == type and it->same();
+    for (types_t::const_iterator it = mTypes.begin(); it != mTypes.end();
+         ++it) {
+        if (mQuantities[*it] > 0) {
+            value->add(ResourceConstraint(*it, mQuantities[*it],
+                                          false).toValue());
+        }
     }
-    return yes;
+    return value;
 }
 
 } // namespace rcpsp
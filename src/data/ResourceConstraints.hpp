@@ -24,6 +24,7 @@
 #ifndef __RESOURCE_CONTRAINTS_HPP
 #define __RESOURCE_CONTRAINTS_HPP 1
 
+#include <algorithm>
 #include <string>
 #include <vle/devs/Time.hpp>
 #include <vle/value/Set.hpp>
@@ -34,7 +35,8 @@
 
 namespace rcpsp {
 
-class ResourceConstraints : public std::vector < ResourceConstraint >
+class ResourceConstraints : public std::vector < ResourceConstraint >,
+                            public ArenaObject
 {
 public:
     ResourceConstraints()
@@ -50,14 +52,20 @@ public:
         }
     }
 
-    static ResourceConstraints* build(const vle::value::Value& value)
-    { return new ResourceConstraints(&value); }
+    ResourceConstraints(Blob::Reader& reader)
+    {
+        unsigned int n = reader.getInteger();
 
-    ResourceConstraints buildResourceConstraints(const Resources* r) const;
+        reserve(n);
+        for (unsigned int i = 0; i < n; ++i) {
+            push_back(ResourceConstraint(reader));
+        }
+    }
 
-    bool checkResourceConstraint(const Resources& r) const;
+    static ResourceConstraints* build(const vle::value::Value& value)
+    { return new ResourceConstraints(&value); }
 
-    unsigned int quantity(const std::string& type) const
+    unsigned int quantity(unsigned int type) const
     {
         const_iterator it = begin();
         bool found = false;
@@ -86,7 +94,7 @@ public:
         return n;
     }
 
-    bool needAgain(const std::string& type) const;
+    bool needAgain(unsigned int type) const;
 
     vle::value::Value* toValue() const
     {
@@ -98,6 +106,80 @@ public:
         return value;
     }
 
+    void write(Blob& blob) const
+    {
+        blob.putInteger(size());
+        for (const_iterator it = begin(); it != end(); ++it) {
+            it->write(blob);
+        }
+    }
+};
+
+/**
+ * The quantities a step still needs, as a dense vector indexed by resource
+ * type. The demand is reset when the step changes and is decremented as
+ * resources are assigned, so building and checking it never allocates
+ * once the vector has grown to the number of types.
+ */
+class ResourceDemand : public ArenaObject
+{
+public:
+    typedef std::vector < unsigned int > types_t;
+
+    ResourceDemand() : mQuantity(0)
+    { }
+
+    ResourceDemand(const vle::value::Value* value);
+
+    void assign(const Resources& r);
+
+    static ResourceDemand* build(const vle::value::Value& value)
+    { return new ResourceDemand(&value); }
+
+    void clear();
+
+    bool empty() const
+    { return mQuantity == 0; }
+
+    unsigned int quantity(unsigned int type) const
+    { return mQuantities[type]; }
+
+    unsigned int quantity() const
+    { return mQuantity; }
+
+    void reset(const ResourceConstraints& rc, const Resources* r);
+
+    unsigned int size() const
+    { return mTypes.size(); }
+
+    void swap(ResourceDemand& demand)
+    {
+        mQuantities.swap(demand.mQuantities);
+        mTypes.swap(demand.mTypes);
+        std::swap(mQuantity, demand.mQuantity);
+    }
+
+    /**
+     * Build the value sent in the events, a blob of (type, quantity)
+     * pairs.
+     */
+    vle::value::Value* toEventValue() const;
+
+    vle::value::Value* toValue() const;
+
+    /**
+     * The types demanded when the demand was reset, some of them may be
+     * satisfied since.
+     */
+    const types_t& types() const
+    { return mTypes; }
+
+private:
+    void add(unsigned int type, unsigned int quantity);
+
+    ResourceTypes mQuantities;
+    types_t mTypes;
+    unsigned int mQuantity;
 };
 
 } // namespace rcpsp
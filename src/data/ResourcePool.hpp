@@ -37,8 +37,8 @@ namespace rcpsp {
 class ResourcePool
 {
 public:
-    ResourcePool(const std::string& name) :
-        mName(name)
+    ResourcePool(const std::string& name, const std::string& type) :
+        mName(name), mType(Symbols::resourceTypes().id(type))
     { }
 
     ResourcePool(const vle::value::Value* value)
@@ -47,65 +47,60 @@ public:
             dynamic_cast < const vle::value::Set* >(value);
 
         mName = vle::value::toString(set->get(0));
-        mType = vle::value::toString(set->get(1));
-        mResources = new Resources(set->get(2));
+        mType = Symbols::resourceTypes().id(
+            vle::value::toString(set->get(1)));
+        mResources = Resources(set->get(2));
         //TODO: mPlannings
     }
 
     virtual ~ResourcePool()
-    { delete mResources; }
+    { }
 
-    void add(Resource* resource)
-    { mResources->push_back(resource); }
+    void add(unsigned int resource)
+    { mResources.insert(resource); }
 
-    Resources* assign(int n)
+    Resources assign(int n)
     {
-        Resources* r = new Resources;
+        Resources r = mResources.first(n);
 
-        for(int i = 0; i < n; ++i) {
-            r->push_back(mResources->back());
-            mResources->pop_back();
-        }
+        mResources.remove(r);
         return r;
     }
 
     //TODO: to include planning constraint
-    Resources* available() const
+    const Resources& available() const
     { return mResources; }
 
     const std::string& name() const
     { return mName; }
 
     int quantity() const
-    { return mResources->size(); }
+    { return mResources.size(); }
 
-    void release(Resources* r)
-    {
-        for(Resources::const_iterator it = r->begin(); it != r->end(); ++it) {
-            if (mType == (*it)->type()) {
-                mResources->push_back(*it);
-            }
-        }
-    }
+    void release(const Resources& r)
+    { mResources.add(r.ofType(mType)); }
 
     vle::value::Value* toValue() const
     {
         vle::value::Set* value = new vle::value::Set;
 
         value->add(new vle::value::String(mName));
-        value->add(new vle::value::String(mType));
-        value->add(mResources->toValue());
+        value->add(new vle::value::String(typeName()));
+        value->add(mResources.toValue());
         //TODO: mPlannings
         return value;
     }
 
-    const std::string& type() const
+    unsigned int type() const
     { return mType; }
 
+    const std::string& typeName() const
+    { return Symbols::resourceTypes().name(mType); }
+
 private:
     std::string mName;
-    std::string mType;
-    Resources* mResources;
+    unsigned int mType;
+    Resources mResources;
     Plannings mPlannings;
 };
 
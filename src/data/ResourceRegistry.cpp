@@ -0,0 +1,87 @@
+/**
+ * @file ResourceRegistry.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <data/ResourceRegistry.hpp>
+
+#include <vle/utils/Exception.hpp>
+
+namespace rcpsp {
+
+// one registry per thread, like the arena, cleared by the run
+static __thread ResourceRegistry* current = 0;
+
+unsigned int ResourceRegistry::add(const std::string& name,
+                                   const std::string& type)
+{
+    ResourceRegistry& r = registry();
+    std::map < std::string, unsigned int >::const_iterator it =
+        r.mIds.find(name);
+
+    if (it == r.mIds.end()) {
+        unsigned int id = r.mResources.size();
+
+        r.mIds[name] = id;
+        r.mResources.push_back(Resource(name, type));
+
+        unsigned int t = r.mResources.back().type();
+
+        if (t >= r.mMasks.size()) {
+            r.mMasks.resize(t + 1);
+        }
+        r.mMasks[t].resize(id + 1);
+        r.mMasks[t].set(id);
+        return id;
+    } else {
+        if (r.mResources[it->second].type() !=
+            Symbols::resourceTypes().id(type)) {
+            throw vle::utils::ModellingError(
+                "resource " + name + " registered with another type: " +
+                type);
+        }
+        return it->second;
+    }
+}
+
+void ResourceRegistry::clear()
+{
+    delete current;
+    current = 0;
+}
+
+const boost::dynamic_bitset < >& ResourceRegistry::mask(unsigned int type)
+{
+    static const boost::dynamic_bitset < > none;
+    const ResourceRegistry& r = registry();
+
+    return type < r.mMasks.size() ? r.mMasks[type] : none;
+}
+
+ResourceRegistry& ResourceRegistry::registry()
+{
+    if (current == 0) {
+        current = new ResourceRegistry;
+    }
+    return *current;
+}
+
+} // namespace rcpsp
@@ -0,0 +1,80 @@
+/**
+ * @file ResourceRegistry.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RESOURCE_REGISTRY_HPP
+#define __RESOURCE_REGISTRY_HPP 1
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <data/Resource.hpp>
+
+namespace rcpsp {
+
+/**
+ * The registry owns every resource exactly once and gives it a stable,
+ * dense identifier. Resources are registered by name when the pools are
+ * loaded; the models and the events only handle the identifiers. A name
+ * is bound to one type. Each thread has its own registry, so the
+ * replications run in parallel do not share it.
+ */
+class ResourceRegistry
+{
+public:
+    static unsigned int add(const std::string& name, const std::string& type);
+
+    /** Forget all the resources, at the end of a run. */
+    static void clear();
+
+    static const Resource& get(unsigned int id)
+    { return registry().mResources[id]; }
+
+    /**
+     * The identifiers of the resources of a type, as a bitset.
+     */
+    static const boost::dynamic_bitset < >& mask(unsigned int type);
+
+    static unsigned int size()
+    { return registry().mResources.size(); }
+
+private:
+    ResourceRegistry()
+    { }
+
+    ResourceRegistry(const ResourceRegistry&);
+    ResourceRegistry& operator=(const ResourceRegistry&);
+
+    static ResourceRegistry& registry();
+
+    std::map < std::string, unsigned int > mIds;
+    std::deque < Resource > mResources;
+    std::vector < boost::dynamic_bitset < > > mMasks;
+};
+
+} // namespace rcpsp
+
+#endif
@@ -25,11 +25,146 @@
 
 namespace rcpsp {
 
+Resources::Resources(const vle::value::Value* value)
+{
+    if (Blob::isBlob(*value)) {
+        Blob::Reader reader(Blob::toBlob(*value));
+
+        read(reader);
+    } else {
+        const vle::value::Set& set = vle::value::toSetValue(*value);
+
+        for (unsigned int i = 0; i < set.size(); ++i) {
+            const vle::value::Value* resource = set.get(i);
+
+            if (resource->isInteger()) {
+                insert(vle::value::toInteger(resource));
+            } else {
+                const vle::value::Set& pair =
+                    vle::value::toSetValue(*resource);
+
+                insert(ResourceRegistry::add(
+                           vle::value::toString(pair.get(0)),
+                           vle::value::toString(pair.get(1))));
+            }
+        }
+    }
+}
+
+Resources::Resources(Blob::Reader& reader)
+{
+    read(reader);
+}
+
+void Resources::add(const Resources& r)
+{
+    if (mBits.size() < r.mBits.size()) {
+        mBits.resize(r.mBits.size());
+    }
+    if (r.mBits.size() == mBits.size()) {
+        mBits |= r.mBits;
+    } else {
+        bits_t bits(r.mBits);
+
+        bits.resize(mBits.size());
+        mBits |= bits;
+    }
+}
+
+unsigned int Resources::count(unsigned int type) const
+{
+    const bits_t& mask = ResourceRegistry::mask(type);
+    unsigned int n = 0;
+
+    for (bits_t::size_type i = mBits.find_first(); i != bits_t::npos;
+         i = mBits.find_next(i)) {
+        if (i < mask.size() and mask.test(i)) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+Resources Resources::first(unsigned int n) const
+{
+    Resources r;
+
+    r.mBits.resize(mBits.size());
+    for (bits_t::size_type i = mBits.find_first();
+         n > 0 and i != bits_t::npos; i = mBits.find_next(i), --n) {
+        r.mBits.set(i);
+    }
+    return r;
+}
+
+void Resources::read(Blob::Reader& reader)
+{
+    unsigned int n = reader.getInteger();
+
+    for (unsigned int i = 0; i < n; ++i) {
+        insert(reader.getInteger());
+    }
+}
+
+Resources Resources::ofType(unsigned int type) const
+{
+    const bits_t& mask = ResourceRegistry::mask(type);
+    Resources r;
+
+    r.mBits.resize(mBits.size());
+    for (bits_t::size_type i = mBits.find_first(); i != bits_t::npos;
+         i = mBits.find_next(i)) {
+        if (i < mask.size() and mask.test(i)) {
+            r.mBits.set(i);
+        }
+    }
+    return r;
+}
+
+void Resources::remove(const Resources& r)
+{
+    if (r.mBits.size() == mBits.size()) {
+        mBits -= r.mBits;
+    } else {
+        bits_t bits(r.mBits);
+
+        bits.resize(mBits.size());
+        mBits -= bits;
+    }
+}
+
+vle::value::Value* Resources::toEventValue() const
+{
+    Blob* blob = new Blob;
+
+    write(*blob);
+    return blob;
+}
+
+vle::value::Value* Resources::toValue() const
+{
+    vle::value::Set* value = new vle::value::Set;
+
+    for (const_iterator it = begin(); it != end(); ++it) {
+        value->add(resource(*it).toValue());
+    }
+    return value;
+}
+
+
+void Resources::write(Blob& blob) const
+{
+    blob.putInteger(size());
+    for (const_iterator it = begin(); it != end(); ++it) {
+        blob.putInteger(*it);
+    }
+}
+
 std::ostream& operator<<(std::ostream& o, const Resources& r)
 {
     o << "{ ";
     for (Resources::const_iterator it = r.begin(); it != r.end(); ++it) {
-        o << **it << " ";
+        o << Resources::resource(*it) << " ";
     }
     o << "}";
     return o;
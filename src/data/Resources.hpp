@@ -27,60 +27,155 @@
 #include <string>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include <vle/devs/ExternalEvent.hpp>
 #include <vle/value/Value.hpp>
 
+#include <data/Arena.hpp>
+#include <data/Blob.hpp>
 #include <data/Resource.hpp>
+#include <data/ResourceRegistry.hpp>
+#include <data/Symbols.hpp>
 
 namespace rcpsp {
 
-class Resources : public std::vector < Resource* >
+/**
+ * A set of resources given by their identifier in the ResourceRegistry,
+ * stored as a bitset: the set operations cost one pass over the words
+ * whatever the number of resources.
+ */
+class Resources : public ArenaObject
 {
 public:
+    typedef boost::dynamic_bitset < > bits_t;
+
+    /**
+     * Iterate over the identifiers of the resources of the set, in
+     * increasing order.
+     */
+    class const_iterator
+    {
+    public:
+        const_iterator(const bits_t* bits, bits_t::size_type position) :
+            mBits(bits), mPosition(position)
+        { }
+
+        unsigned int operator*() const
+        { return mPosition; }
+
+        const_iterator& operator++()
+        {
+            mPosition = mBits->find_next(mPosition);
+            return *this;
+        }
+
+        bool operator==(const const_iterator& it) const
+        { return mPosition == it.mPosition; }
+
+        bool operator!=(const const_iterator& it) const
+        { return mPosition != it.mPosition; }
+
+    private:
+        const bits_t* mBits;
+        bits_t::size_type mPosition;
+    };
+
     Resources()
     { }
 
-    Resources(const vle::value::Value* value)
-    {
-        const vle::value::Set* set =
-            dynamic_cast < const vle::value::Set* >(value);
+    Resources(const vle::value::Value* value);
 
-        for (unsigned int i = 0; i < set->size(); ++i) {
-            push_back(new Resource(set->get(i)));
-        }
-    }
+    Resources(Blob::Reader& reader);
 
     virtual ~Resources()
     { }
 
-    void add(const Resources& r)
-    {
-        for (Resources::const_iterator itr = r.begin(); itr != r.end();
-             ++itr) {
-            push_back(*itr);
-        }
-    }
+    void add(const Resources& r);
+
+    const_iterator begin() const
+    { return const_iterator(&mBits, mBits.find_first()); }
 
     static Resources* build(const vle::value::Value& value)
     { return new Resources(&value); }
 
+    void clear()
+    { mBits.reset(); }
+
+    bool contains(unsigned int id) const
+    { return id < mBits.size() and mBits.test(id); }
+
+    /**
+     * Count the resources of the given type, reading the mask of the
+     * registry in place.
+     */
+    unsigned int count(unsigned int type) const;
+
+    bool empty() const
+    { return mBits.none(); }
+
+    const_iterator end() const
+    { return const_iterator(&mBits, bits_t::npos); }
+
+    /**
+     * Select the n first resources of the set, or all of them if the set
+     * is smaller.
+     */
+    Resources first(unsigned int n) const;
+
     static const vle::value::Value& get(const vle::devs::ExternalEvent* ee)
     { return ee->getAttributeValue("resources"); }
 
-    vle::value::Value* toValue() const
+    void insert(unsigned int id)
     {
-        vle::value::Set* value = new vle::value::Set;
-
-        for (const_iterator it = begin(); it != end(); ++it) {
-            value->add((*it)->toValue());
+        if (id >= mBits.size()) {
+            mBits.resize(id + 1);
         }
-        return value;
+        mBits.set(id);
     }
+
+    /**
+     * Select the resources of the given type, reading the mask of the
+     * registry in place.
+     */
+    Resources ofType(unsigned int type) const;
+
+    void remove(const Resources& r);
+
+    static const Resource& resource(unsigned int id)
+    { return ResourceRegistry::get(id); }
+
+    unsigned int size() const
+    { return mBits.count(); }
+
+    void swap(Resources& r)
+    { mBits.swap(r.mBits); }
+
+    /**
+     * Build the value sent in the events, a blob of identifiers.
+     */
+    vle::value::Value* toEventValue() const;
+
+    /**
+     * Build the value observed, the (name, type) pairs of the resources:
+     * the identifiers only travel in the events.
+     */
+    vle::value::Value* toValue() const;
+
+    void write(Blob& blob) const;
+
+private:
+    void read(Blob::Reader& reader);
+
+    bits_t mBits;
 };
 
 std::ostream& operator<<(std::ostream& o, const Resources& r);
 
-class ResourceTypes : public std::map < std::string, unsigned int >
+/**
+ * A quantity per resource type, indexed by the identifier of the type.
+ */
+class ResourceTypes : public std::vector < unsigned int >
 {
 public:
     ResourceTypes()
@@ -93,8 +188,8 @@ public:
 
         for (vle::value::Map::const_iterator it = map->begin();
              it != map->end(); ++it) {
-            insert(std::make_pair(it->first,
-                                  vle::value::toInteger(it->second)));
+            operator[](Symbols::resourceTypes().id(it->first)) =
+                vle::value::toInteger(it->second);
         }
     }
 
@@ -104,12 +199,29 @@ public:
     static const vle::value::Value& get(const vle::devs::ExternalEvent* ee)
     { return ee->getAttributeValue("resources"); }
 
+    unsigned int& operator[](unsigned int type)
+    {
+        if (type >= size()) {
+            resize(type + 1, 0);
+        }
+        return std::vector < unsigned int >::operator[](type);
+    }
+
+    unsigned int operator[](unsigned int type) const
+    {
+        return type < size() ?
+            std::vector < unsigned int >::operator[](type) : 0;
+    }
+
     vle::value::Value* toValue() const
     {
         vle::value::Map* value = new vle::value::Map;
 
-        for (const_iterator it = begin(); it != end(); ++it) {
-            value->add(it->first, new vle::value::Integer(it->second));
+        for (unsigned int type = 0; type < size(); ++type) {
+            if (operator[](type) > 0) {
+                value->add(Symbols::resourceTypes().name(type),
+                           new vle::value::Integer(operator[](type)));
+            }
         }
         return value;
     }
@@ -0,0 +1,53 @@
+/**
+ * @file Run.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <data/Arena.hpp>
+#include <data/ResourceRegistry.hpp>
+#include <data/Run.hpp>
+#include <data/Symbols.hpp>
+
+namespace rcpsp {
+
+static __thread unsigned int count = 0;
+
+Run::Run()
+{
+    ++count;
+}
+
+Run::~Run()
+{
+    if (--count == 0) {
+        ResourceRegistry::clear();
+        Symbols::clear();
+        Arena::purge();
+    }
+}
+
+unsigned int Run::models()
+{
+    return count;
+}
+
+} // namespace rcpsp
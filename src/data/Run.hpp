@@ -0,0 +1,53 @@
+/**
+ * @file Run.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __RUN_HPP
+#define __RUN_HPP 1
+
+namespace rcpsp {
+
+/**
+ * The lifetime of a simulation in a thread. Each model holds a Run; when
+ * the last one of the thread is destroyed, the resource registry and the
+ * symbols are cleared, so the next simulation of the thread starts from
+ * empty tables, and the arena is purged.
+ */
+class Run
+{
+public:
+    Run();
+
+    ~Run();
+
+    /** The number of models of the simulation in the thread. */
+    static unsigned int models();
+
+private:
+    Run(const Run&);
+    Run& operator=(const Run&);
+};
+
+} // namespace rcpsp
+
+#endif
@@ -29,13 +29,14 @@
 
 #include <vle/value/Value.hpp>
 
+#include <data/Arena.hpp>
 #include <data/Location.hpp>
 #include <data/ResourceConstraints.hpp>
 #include <data/TemporalConstraints.hpp>
 
 namespace rcpsp {
 
-class Step
+class Step : public ArenaObject
 {
 public:
     Step(const std::string& name,
@@ -47,12 +48,7 @@ public:
         mDuration(duration),
         mLocation(location),
         mResourceConstraints(resourceConstraints),
-        mTemporalConstraints(temporalConstraints),
-        mWaiting(false),
-        mRunning(false),
-        mDone(false),
-        mStartDate(vle::devs::infinity),
-        mFinishDate(vle::devs::infinity)
+        mTemporalConstraints(temporalConstraints)
     { }
 
     Step(const vle::value::Value* value)
@@ -65,43 +61,29 @@ public:
         mLocation = Location(set->get(2));
         mResourceConstraints = ResourceConstraints(set->get(3));
         mTemporalConstraints = TemporalConstraints(set->get(4));
-
-        mWaiting = false;
-        mRunning = false;
-        mDone = false;
-        mStartDate = vle::devs::infinity;
-        mFinishDate = vle::devs::infinity;
     }
 
-    virtual ~Step()
+    Step(Blob::Reader& reader) :
+        mName(reader.getString()),
+        mDuration(reader.getDouble()),
+        mLocation(reader),
+        mResourceConstraints(reader),
+        mTemporalConstraints(reader)
     { }
 
-    ResourceConstraints buildResourceConstraints(const Resources* r) const
-    { return mResourceConstraints.buildResourceConstraints(r); }
-
-    bool checkResourceConstraint(const Resources& r) const
-    { return mResourceConstraints.checkResourceConstraint(r); }
-
-    bool done(const vle::devs::Time& time) const
-    { return mDuration == time - mStartDate; }
+    virtual ~Step()
+    { }
 
     const vle::devs::Time& duration() const
     { return mDuration; }
 
-    void finish(const vle::devs::Time& time)
-    {
-        mFinishDate = time;
-        mRunning = false;
-        mDone = true;
-    }
-
     const Location& location() const
     { return mLocation; }
 
     const std::string& name() const
     { return mName; }
 
-    bool needAgain(const std::string& type) const
+    bool needAgain(unsigned int type) const
     { return mResourceConstraints.needAgain(type); }
 
     virtual bool operator==(const Step& s) const
@@ -110,19 +92,9 @@ public:
     virtual bool operator==(const std::string& name) const
     { return mName == name; }
 
-    vle::devs::Time remainingTime(const vle::devs::Time& time) const
-    { return mDuration - (time - mStartDate); }
-
     const ResourceConstraints& resourceConstraints() const
     { return mResourceConstraints; }
 
-    void start(const vle::devs::Time& time)
-    {
-        mStartDate = time;
-        mWaiting = false;
-        mRunning = true;
-    }
-
     bool starting(const vle::devs::Time& time) const
     { return mTemporalConstraints.starting(time); }
 
@@ -141,10 +113,13 @@ public:
         return value;
     }
 
-    void wait(const vle::devs::Time& time)
+    void write(Blob& blob) const
     {
-        mWaitDate = time;
-        mWaiting = true;
+        blob.putString(mName);
+        blob.putDouble(mDuration);
+        mLocation.write(blob);
+        mResourceConstraints.write(blob);
+        mTemporalConstraints.write(blob);
     }
 
 private:
@@ -155,15 +130,6 @@ private:
     Location mLocation;
     ResourceConstraints mResourceConstraints;
     TemporalConstraints mTemporalConstraints;
-
-    // state
-    bool mWaiting;
-    bool mRunning;
-    bool mDone;
-
-    vle::devs::Time mWaitDate;
-    vle::devs::Time mStartDate;
-    vle::devs::Time mFinishDate;
 };
 
 std::ostream& operator<<(std::ostream& o, const Step& s);
@@ -25,9 +25,9 @@
 
 namespace rcpsp {
 
-Steps::iterator Steps::find(const std::string& name)
+Steps::const_iterator Steps::find(const std::string& name) const
 {
-    Steps::iterator it = begin();
+    Steps::const_iterator it = begin();
     bool found = false;
 
     while (not found and it != end()) {
@@ -40,6 +40,17 @@ Steps::iterator Steps::find(const std::string& name)
     return it;
 }
 
+vle::devs::Time Steps::work(unsigned int index) const
+{
+    if (mWork.size() != size() + 1) {
+        mWork.assign(size() + 1, 0);
+        for (unsigned int i = size(); i > 0; --i) {
+            mWork[i - 1] = mWork[i] + operator[](i - 1)->duration();
+        }
+    }
+    return mWork[index];
+}
+
 std::ostream& operator<<(std::ostream& o, const Steps& s)
 {
     o << "{ ";
@@ -28,13 +28,13 @@
 
 namespace rcpsp {
 
-class Steps : public std::vector < Step* >
+class Steps : public std::vector < Step* >, public ArenaObject
 {
 public:
     Steps()
     { }
 
-    Steps(const Steps& s) : std::vector < Step* >(s)
+    Steps(const Steps& s) : std::vector < Step* >()
     {
         for(const_iterator it = s.begin(); it != s.end(); ++it)
             push_back(new Step(**it));
@@ -50,10 +50,26 @@ public:
         }
     }
 
+    Steps(Blob::Reader& reader)
+    {
+        unsigned int n = reader.getInteger();
+
+        reserve(n);
+        for (unsigned int i = 0; i < n; ++i) {
+            push_back(new Step(reader));
+        }
+    }
+
     virtual ~Steps()
     { for(iterator it = begin(); it != end(); ++it) delete *it; }
 
-    Steps::iterator find(const std::string& name);
+    Steps::const_iterator find(const std::string& name) const;
+
+    /**
+     * The total duration of the steps from the given index to the end,
+     * computed once for all the indexes.
+     */
+    vle::devs::Time work(unsigned int index) const;
 
     vle::value::Value* toValue() const
     {
@@ -64,6 +80,17 @@ public:
         }
         return value;
     }
+
+    void write(Blob& blob) const
+    {
+        blob.putInteger(size());
+        for (const_iterator it = begin(); it != end(); ++it) {
+            (*it)->write(blob);
+        }
+    }
+
+private:
+    mutable std::vector < vle::devs::Time > mWork;
 };
 
 std::ostream& operator<<(std::ostream& o, const Steps& s);
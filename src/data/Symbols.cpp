@@ -0,0 +1,72 @@
+/**
+ * @file Symbols.cpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <data/Symbols.hpp>
+
+namespace rcpsp {
+
+// the symbols of the run of the thread
+static __thread Symbols* currentLocations = 0;
+static __thread Symbols* currentResourceTypes = 0;
+
+void Symbols::clear()
+{
+    delete currentLocations;
+    currentLocations = 0;
+    delete currentResourceTypes;
+    currentResourceTypes = 0;
+}
+
+unsigned int Symbols::id(const std::string& name)
+{
+    std::map < std::string, unsigned int >::const_iterator it =
+        mIds.find(name);
+
+    if (it == mIds.end()) {
+        unsigned int id = mNames.size();
+
+        mIds[name] = id;
+        mNames.push_back(name);
+        return id;
+    } else {
+        return it->second;
+    }
+}
+
+Symbols& Symbols::locations()
+{
+    if (currentLocations == 0) {
+        currentLocations = new Symbols;
+    }
+    return *currentLocations;
+}
+
+Symbols& Symbols::resourceTypes()
+{
+    if (currentResourceTypes == 0) {
+        currentResourceTypes = new Symbols;
+    }
+    return *currentResourceTypes;
+}
+
+} // namespace rcpsp
@@ -0,0 +1,73 @@
+/**
+ * @file Symbols.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SYMBOLS_HPP
+#define __SYMBOLS_HPP 1
+
+#include <deque>
+#include <map>
+#include <string>
+
+namespace rcpsp {
+
+/**
+ * A symbol table mapping names to dense integer identifiers.
+ *
+ * The names are interned when the problem is loaded; afterwards the
+ * models compare and index resource types and locations by identifier.
+ * The tables are shared by all the models of a thread, so an identifier
+ * means the same thing on both sides of an event, and the replications
+ * run in other threads have their own.
+ */
+class Symbols
+{
+public:
+    Symbols()
+    { }
+
+    /** Forget the locations and the resource types, at the end of a run. */
+    static void clear();
+
+    unsigned int id(const std::string& name);
+
+    static Symbols& locations();
+
+    const std::string& name(unsigned int id) const
+    { return mNames[id]; }
+
+    static Symbols& resourceTypes();
+
+    unsigned int size() const
+    { return mNames.size(); }
+
+private:
+    Symbols(const Symbols&);
+    Symbols& operator=(const Symbols&);
+
+    std::map < std::string, unsigned int > mIds;
+    std::deque < std::string > mNames;
+};
+
+} // namespace rcpsp
+
+#endif
@@ -31,6 +31,8 @@
 #include <vle/value/Set.hpp>
 #include <vle/value/Value.hpp>
 
+#include <data/Blob.hpp>
+
 namespace rcpsp {
 
 class TemporalConstraints
@@ -78,6 +80,15 @@ public:
         mLateFinishTime = (vle::devs::Time)vle::value::toDouble(set->get(4));
     }
 
+    TemporalConstraints(Blob::Reader& reader)
+    {
+        mType = (Type)reader.getInteger();
+        mEarlyStartTime = reader.getDouble();
+        mLateStartTime = reader.getDouble();
+        mEarlyFinishTime = reader.getDouble();
+        mLateFinishTime = reader.getDouble();
+    }
+
     bool starting(const vle::devs::Time& time) const
     {
         if (mType & (ES | LS)) {
@@ -110,6 +121,15 @@ public:
         return value;
     }
 
+    void write(Blob& blob) const
+    {
+        blob.putInteger(mType);
+        blob.putDouble(mEarlyStartTime);
+        blob.putDouble(mLateStartTime);
+        blob.putDouble(mEarlyFinishTime);
+        blob.putDouble(mLateFinishTime);
+    }
+
 private:
     friend std::ostream& operator<<(std::ostream& o,
                                     const TemporalConstraints& tc);
@@ -0,0 +1,43 @@
+/**
+ * @file Time.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TIME_HPP
+#define __TIME_HPP 1
+
+#include <algorithm>
+#include <cmath>
+
+#include <vle/devs/Time.hpp>
+
+namespace rcpsp {
+
+/**
+ * Whether the date is reached at the time. The dates are sums of
+ * durations, so they are compared up to the rounding of the time.
+ */
+inline bool reached(const vle::devs::Time& date, const vle::devs::Time& time)
+{ return date <= time + 1e-9 * std::max(1., std::fabs(time)); }
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file TransitCalendar.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __TRANSIT_CALENDAR_HPP
+#define __TRANSIT_CALENDAR_HPP 1
+
+#include <data/Activity.hpp>
+#include <data/Time.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace rcpsp {
+
+/**
+ * The activities in transit, ordered by their out date. The out dates are
+ * sums of durations, so an activity is out up to the rounding of the
+ * time. The calendar owns the activities.
+ */
+class TransitCalendar
+{
+public:
+    typedef std::multimap < vle::devs::Time, Activity* > arrivals_t;
+    typedef arrivals_t::const_iterator const_iterator;
+
+    TransitCalendar()
+    { }
+
+    virtual ~TransitCalendar()
+    {
+        for (arrivals_t::iterator it = mArrivals.begin();
+             it != mArrivals.end(); ++it) {
+            delete it->second;
+        }
+    }
+
+    const_iterator begin() const
+    { return mArrivals.begin(); }
+
+    bool empty() const
+    { return mArrivals.empty(); }
+
+    const_iterator end() const
+    { return mArrivals.end(); }
+
+    /** The duration until the next out date, infinity if none. */
+    vle::devs::Time next(const vle::devs::Time& time) const
+    {
+        if (mArrivals.empty()) {
+            return vle::devs::infinity;
+        }
+        return std::max(0., mArrivals.begin()->first - time);
+    }
+
+    void push(Activity* activity, const vle::devs::Time& date)
+    { mArrivals.insert(std::make_pair(date, activity)); }
+
+    /** Delete the activities out at the time. */
+    void removeArrived(const vle::devs::Time& time)
+    {
+        while (not mArrivals.empty() and
+               reached(mArrivals.begin()->first, time)) {
+            delete mArrivals.begin()->second;
+            mArrivals.erase(mArrivals.begin());
+        }
+    }
+
+    unsigned int size() const
+    { return mArrivals.size(); }
+
+private:
+    TransitCalendar(const TransitCalendar&);
+    TransitCalendar& operator=(const TransitCalendar&);
+
+    arrivals_t mArrivals;
+};
+
+} // namespace rcpsp
+
+#endif
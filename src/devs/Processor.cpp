@@ -48,7 +48,7 @@ void Processor::output(const vle::devs::Time& /* time */,
             vle::devs::ExternalEvent* ee =
                 new vle::devs::ExternalEvent("done");
 
-            ee << vle::devs::attribute("activity", (*it)->toValue());
+            ee << vle::devs::attribute("activity", (*it)->toEventValue());
             output.push_back(ee);
         }
     }
@@ -24,6 +24,7 @@
 #include <vle/devs/Dynamics.hpp>
 
 #include <data/Activities.hpp>
+#include <data/Run.hpp>
 
 namespace rcpsp { namespace devs {
 
@@ -55,6 +56,7 @@ public:
         const vle::devs::ObservationEvent& event) const;
 
 protected:
+    Run mRun;
     Activities mRunningActivities;
     Activities mDoneActivities;
 
@@ -24,24 +24,83 @@
 #include <vle/devs/Dynamics.hpp>
 
 #include <data/Activities.hpp>
+#include <data/FreeResources.hpp>
+#include <data/Run.hpp>
 
 namespace rcpsp { namespace devs {
 
+/**
+ * The scheduler of the steps of a location, specialized for a policy.
+ * The policy is a member of known type and its functions are called with
+ * a qualified name, so they are bound statically and can be inlined. The
+ * models are instantiated in StepScheduler.cpp for the shipped policies
+ * and for RuntimePolicy, which chooses one at run time. The definitions
+ * are in StepScheduler.tpp, which a model with its own policy includes to
+ * instantiate StepScheduler < MyPolicy >.
+ *
+ * Once the pools publish the resources they release on the "released"
+ * port, the scheduler knows the free quantity of the types it missed and
+ * only demands the resources of the activities which could get them:
+ * while none could, it waits for a release instead of trying the queue.
+ */
+template < class Policy >
 class StepScheduler : public vle::devs::Dynamics
 {
 public:
     StepScheduler(const vle::devs::DynamicsInit& init,
                   const vle::devs::InitEventList& events);
 
-    virtual void add(Activity* a) =0;
-    virtual bool another() const =0;
-    virtual bool demand() const =0;
-    virtual bool empty() const =0;
-    virtual bool next() =0;
-    virtual void remove(Activity* a) =0;
-    virtual void reset() =0;
-    virtual Activity* select() const =0;
-    virtual vle::value::Value* observe() const =0;
+    virtual ~StepScheduler()
+    { }
+
+    void add(Activity* a)
+    { mWaitingActivities.push(a, mPolicy.Policy::priority(a)); }
+
+    /**
+     * Move the policy to the next waiting activity whose demand the known
+     * free resources may satisfy.
+     */
+    bool candidate();
+
+    bool another() const
+    { return mPolicy.Policy::another(); }
+
+    bool demand() const
+    { return mPolicy.Policy::demand(); }
+
+    bool empty() const
+    { return mWaitingActivities.empty(); }
+
+    bool next()
+    { return mPolicy.Policy::next(); }
+
+    /**
+     * Remove a waiting activity. The selection of the policy may point to
+     * it, so it is reset.
+     */
+    void remove(Activity* a)
+    {
+        mWaitingActivities.erase(a);
+        reset();
+    }
+
+    void reset()
+    { mPolicy.Policy::reset(); }
+
+    /**
+     * Select a waiting activity whose demand may be satisfied, from the
+     * current one of the policy.
+     */
+    bool retry()
+    { return satisfiable(select()) or candidate(); }
+
+    bool satisfiable(const Activity* a) const;
+
+    Activity* select() const
+    { return mPolicy.Policy::select(); }
+
+    vle::value::Value* observe() const
+    { return mWaitingActivities.toValue(); }
 
     virtual vle::devs::Time init(const vle::devs::Time& /* time */);
     virtual void output(const vle::devs::Time& time,
@@ -58,20 +117,30 @@ public:
         const vle::devs::ObservationEvent& event) const;
 
 private:
+    /** Demand the resources of a waiting activity or wait for them. */
+    void schedule();
+
     enum Phase { WAIT_SCHEDULE, WAIT_ASSIGN, WAIT_RESOURCE, SEND_DEMAND,
                  SEND_DONE, SEND_OUT_DEMAND, SEND_PROCESS, SEND_RELEASE,
                  SEND_SCHEDULE };
 
-    std::string mLocation;
+    Run mRun;
+    Location mLocation;
 
     Phase mPhase;
     Activity* mRunningActivity;
+    Activity* mDemandingActivity;
     Activities mDoneActivities;
     Activities mReleasedActivities;
     Activities mSchedulingActivities;
 
     ResourceTypes* mUnavailableResources;
     ResourceTypes mUsedResources;
+    FreeResources mFreeResources;
+    bool mSubscribed;
+
+    WaitingActivities mWaitingActivities;
+    Policy mPolicy;
 };
 
 } } // namespace devs rcpsp
@@ -0,0 +1,401 @@
+/**
+ * @file devs/StepScheduler.tpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __STEP_SCHEDULER_TPP
+#define __STEP_SCHEDULER_TPP 1
+
+#include <devs/StepScheduler.hpp>
+
+#include <vle/utils/Trace.hpp>
+
+// #include <iostream>
+
+namespace rcpsp { namespace devs {
+
+template < class Policy >
+StepScheduler < Policy >::StepScheduler(
+    const vle::devs::DynamicsInit& init,
+    const vle::devs::InitEventList& events) :
+    vle::devs::Dynamics(init, events),
+    mLocation(vle::value::toString(events.get("location"))),
+    mPolicy(mWaitingActivities)
+{
+    mPolicy.Policy::configure(events);
+}
+
+template < class Policy >
+bool StepScheduler < Policy >::candidate()
+{
+    while (another() and next()) {
+        if (satisfiable(select())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template < class Policy >
+bool StepScheduler < Policy >::satisfiable(const Activity* a) const
+{
+    return not mSubscribed or mFreeResources.satisfiable(a->demand());
+}
+
+template < class Policy >
+void StepScheduler < Policy >::schedule()
+{
+    if (empty()) {
+        mPhase = WAIT_SCHEDULE;
+    } else if (retry()) {
+        mPhase = SEND_DEMAND;
+    } else {
+        mPhase = WAIT_RESOURCE;
+    }
+}
+
+template < class Policy >
+vle::devs::Time StepScheduler < Policy >::init(
+    const vle::devs::Time& /* time */)
+{
+    mRunningActivity = 0;
+    mDemandingActivity = 0;
+    mUnavailableResources = 0;
+    mSubscribed = false;
+    mPhase = WAIT_SCHEDULE;
+    return vle::devs::infinity;
+}
+
+template < class Policy >
+void StepScheduler < Policy >::output(
+    const vle::devs::Time& time,
+    vle::devs::ExternalEventList& output) const
+{
+    if (mPhase == SEND_DEMAND) {
+        if (not empty()) { // est ce utile ???
+            Activity* a = select();
+
+            if (not a->demand().empty()) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("demand");
+
+                TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% - demand") %
+                           getModel().getParentName() % getModelName() %
+                           time % a->name());
+
+                ee << vle::devs::attribute("requester", a->name());
+                ee << vle::devs::attribute("resources",
+                                           a->demand().toEventValue());
+                output.push_back(ee);
+            }
+        }
+    } else if (mPhase == SEND_PROCESS) {
+        if (mRunningActivity) { // est ce utile ???
+            vle::devs::ExternalEvent* ee =
+                new vle::devs::ExternalEvent("process");
+
+            TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% - process") %
+                       getModel().getParentName() % getModelName() %
+                       time % mRunningActivity->name());
+
+            ee << vle::devs::attribute("activity",
+                                       mRunningActivity->toEventValue());
+            output.push_back(ee);
+        }
+    } else if (mPhase == SEND_SCHEDULE) {
+        for(Activities::const_iterator it = mSchedulingActivities.begin();
+            it != mSchedulingActivities.end(); ++it) {
+            vle::devs::ExternalEvent* ee =
+                new vle::devs::ExternalEvent("schedule");
+
+            ee << vle::devs::attribute("previous", mLocation.name());
+            ee << vle::devs::attribute("location",
+                                       (*it)->location().name());
+            ee << vle::devs::attribute("activity", (*it)->toEventValue());
+            output.push_back(ee);
+        }
+    } else if (mPhase == SEND_DONE) {
+        for(Activities::const_iterator it = mDoneActivities.begin();
+            it != mDoneActivities.end(); ++it) {
+
+            TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% - done") %
+                       getModel().getParentName() % getModelName() %
+                       time % (*it)->name());
+
+            vle::devs::ExternalEvent* ee =
+                new vle::devs::ExternalEvent("done");
+
+            ee << vle::devs::attribute("activity", (*it)->toEventValue());
+            output.push_back(ee);
+        }
+    } else if (mPhase == SEND_RELEASE) {
+        for(Activities::const_iterator it = mReleasedActivities.begin();
+            it != mReleasedActivities.end(); ++it) {
+
+            TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% - release => %5%")
+                       % getModel().getParentName() % getModelName() %
+                       time % (*it)->name() % (*it)->allocatedResources());
+
+            Resources releasedResources = (*it)->releasedResources();
+
+            if (not releasedResources.empty()) {
+                vle::devs::ExternalEvent* ee =
+                    new vle::devs::ExternalEvent("release");
+
+		TraceModel(vle::fmt(" [%1%:%2%] at %3% -> %4% - release => %5%")
+			   % getModel().getParentName() % getModelName() %
+			   time % (*it)->name() % releasedResources);
+
+                ee << vle::devs::attribute(
+                    "resources", releasedResources.toEventValue());
+                output.push_back(ee);
+            }
+        }
+    } else if (mPhase == SEND_OUT_DEMAND) {
+        vle::devs::ExternalEvent* ee =
+            new vle::devs::ExternalEvent("out_demand");
+
+        ee << vle::devs::attribute("resources",
+                                   mUnavailableResources->toValue());
+        output.push_back(ee);
+    }
+}
+
+template < class Policy >
+vle::devs::Time StepScheduler < Policy >::timeAdvance() const
+{
+    if (mPhase == SEND_DEMAND or mPhase == SEND_DONE or
+        mPhase == SEND_OUT_DEMAND or mPhase == SEND_PROCESS or
+        mPhase == SEND_RELEASE or mPhase == SEND_SCHEDULE) {
+        return 0;
+    } else {
+        return vle::devs::infinity;
+    }
+}
+
+template < class Policy >
+void StepScheduler < Policy >::internalTransition(
+    const vle::devs::Time& time)
+{
+
+    // std::cout << "BEGIN INTERNAL " << std::endl;
+    // std::cout << time << " => " << mPhase << std::endl;
+
+    if (mPhase == SEND_DEMAND) {
+        Activity* a = select();
+
+        if (a->demand().empty()) {
+            mRunningActivity = a;
+            remove(a);
+            mPhase = SEND_PROCESS;
+        } else {
+            mDemandingActivity = a;
+            mPhase = WAIT_ASSIGN;
+        }
+    } else if (mPhase == SEND_DONE) {
+        mDoneActivities.clear();
+        schedule();
+    } else if (mPhase == SEND_PROCESS) {
+        if (mRunningActivity) { // est-ce utile ?
+            const Resources& r = mRunningActivity->allocatedResources();
+
+            for (Resources::const_iterator it = r.begin(); it != r.end();
+                 ++it) {
+                ++mUsedResources[Resources::resource(*it).type()];
+            }
+            mPolicy.Policy::started(mRunningActivity, time);
+
+            delete mRunningActivity;
+            mRunningActivity = 0;
+        }
+	if (not mReleasedActivities.empty()) {
+            mPhase = SEND_RELEASE;
+	} else {
+            schedule();
+	}
+    } else if (mPhase == SEND_RELEASE) {
+        while (not mReleasedActivities.empty()) {
+            Activity* a = mReleasedActivities.front();
+
+            a->release();
+            if (a->end()) {
+                mDoneActivities.push_back(a);
+                mPhase = SEND_DONE;
+            } else {
+                if (mLocation == a->location()) {
+                    add(a);
+                    mPhase = SEND_DEMAND;
+                } else {
+                    mSchedulingActivities.push_back(a);
+                    mPhase = SEND_SCHEDULE;
+                }
+            }
+            mReleasedActivities.erase(mReleasedActivities.begin());
+        }
+    } else if (mPhase == SEND_SCHEDULE) {
+        mSchedulingActivities.clear();
+        schedule();
+    }
+
+    // std::cout << time << " => " << mPhase << std::endl;
+    // std::cout << "END INTERNAL " << std::endl;
+
+}
+
+template < class Policy >
+void StepScheduler < Policy >::externalTransition(
+    const vle::devs::ExternalEventList& events,
+    const vle::devs::Time& time)
+{
+    vle::devs::ExternalEventList::const_iterator it = events.begin();
+
+    // std::cout << time << " == BEGIN BAG == " << std::endl;
+
+    while (it != events.end()) {
+
+        // std::cout << time << ": externalEvent => "
+        //           << (*it)->getPortName() << " / " << mPhase
+        //           << std::endl;
+
+        if ((*it)->onPort("schedule")) {
+            if (Location::get(*it) == mLocation.name()) {
+                Activity* a = Activity::build(Activity::get(*it));
+
+                TraceModel(
+                    vle::fmt(" [%1%:%2%] at %3% -> schedule = %4%/%5% [%6%]") %
+                    getModel().getParentName() % getModelName() %
+                    time % a->current()->name() % a->name() % mPhase);
+
+                add(a);
+                if (mPhase == WAIT_SCHEDULE) {
+                    mPhase = SEND_DEMAND;
+                } else if (mPhase == WAIT_RESOURCE) {
+                    if (a->demand().empty()) {
+                        mRunningActivity = a;
+                        remove(a);
+                        mPhase = SEND_PROCESS;
+                    } else if (mSubscribed and retry()) {
+                        mPhase = SEND_DEMAND;
+                    }
+		}
+            }
+        } else if ((*it)->onPort("assign") and mDemandingActivity) {
+            Resources r(&Resources::get(*it));
+            Activity* a = mDemandingActivity;
+
+            a->assign(r);
+            mFreeResources.assigned(r);
+
+            TraceModel(
+                vle::fmt(
+                    " [%1%:%2%] at %3% -> assign = %4% -> %5% -> %6%")
+                % getModel().getParentName() % getModelName() %
+                time % r.size() % a->name() % a->allocatedResources());
+
+            if (a->checkResourceConstraint()) {
+                mRunningActivity = a;
+                mDemandingActivity = 0;
+                remove(a);
+                mPhase = SEND_PROCESS;
+            }
+        } else if ((*it)->onPort("done")) {
+            Activity* a = Activity::build(Activity::get(*it));
+
+            TraceModel(
+                vle::fmt(" [%1%:%2%] at %3% -> done = %4% [%5%]") %
+                getModel().getParentName() % getModelName() %
+                time % a->name() % mPhase);
+
+            mPolicy.Policy::finished(a);
+            mReleasedActivities.push_back(a);
+	    if (mPhase == WAIT_SCHEDULE or mPhase == WAIT_RESOURCE) {
+                mPhase = SEND_RELEASE;
+	    }
+        }  else if ((*it)->onPort("unavailable") and mDemandingActivity) {
+            ResourceTypes missing(&ResourceTypes::get(*it));
+
+            mFreeResources.refused(mDemandingActivity->demand(), missing);
+            mDemandingActivity = 0;
+            mPolicy.Policy::unavailable(missing, time);
+            if (demand()) {
+                mUnavailableResources = ResourceTypes::build(
+                    ResourceTypes::get(*it));
+                mPhase = SEND_OUT_DEMAND;
+            } else {
+                if (candidate()) {
+                    mPhase = SEND_DEMAND;
+                } else {
+                    if (not mReleasedActivities.empty()) {
+                        mPhase = SEND_RELEASE;
+                    } else {
+                        mPhase = WAIT_RESOURCE;
+                    }
+                }
+            }
+        }
+        ++it;
+    }
+
+    // the releases are counted after the answers of the bag, which were
+    // computed before them
+    for (it = events.begin(); it != events.end(); ++it) {
+        if ((*it)->onPort("released")) {
+            ResourceTypes released(&ResourceTypes::get(*it));
+
+            mFreeResources.released(released);
+            mSubscribed = true;
+            if (mPhase == WAIT_RESOURCE and retry()) {
+                mPhase = SEND_DEMAND;
+            }
+        }
+    }
+
+    // std::cout << time << " => " << mPhase << std::endl;
+    // std::cout << time << " == END BAG == " << std::endl;
+
+}
+
+template < class Policy >
+void StepScheduler < Policy >::confluentTransitions(
+    const vle::devs::Time& time,
+    const vle::devs::ExternalEventList& events)
+{
+    TraceModel(vle::fmt(" [%1%:%2%] at %3% -> confluent !") %
+               getModel().getParentName() % getModelName() %
+               time);
+
+    internalTransition(time);
+    externalTransition(events, time);
+}
+
+template < class Policy >
+vle::value::Value* StepScheduler < Policy >::observation(
+    const vle::devs::ObservationEvent& event) const
+{
+    if (event.onPort("waiting")) {
+        return observe();
+    }
+    return 0;
+}
+
+} } // namespace devs rcpsp
+
+#endif
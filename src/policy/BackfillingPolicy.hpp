@@ -0,0 +1,160 @@
+/**
+ * @file BackfillingPolicy.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BACKFILLING_POLICY_HPP
+#define __BACKFILLING_POLICY_HPP 1
+
+#include <map>
+#include <string>
+
+#include <policy/PriorityPolicy.hpp>
+
+namespace rcpsp {
+
+/**
+ * EASY backfilling over the arrival order. When the first waiting
+ * activity cannot get its resources, the policy reserves them at the
+ * earliest time the running steps release enough units of the missing
+ * types, known from their durations. A later activity is then only tried
+ * if its step ends before this reservation or does not need any of the
+ * missing types, so it cannot delay the first one.
+ */
+class BackfillingPolicy : public PriorityPolicy
+{
+    typedef std::multimap < vle::devs::Time, ResourceTypes > running_t;
+    typedef std::map < unsigned int, running_t::iterator > handles_t;
+
+public:
+    BackfillingPolicy(WaitingActivities& waitingActivities) :
+    PriorityPolicy(waitingActivities), mTime(0),
+    mReservation(vle::devs::infinity)
+    { }
+
+    virtual void finished(const Activity* a)
+    {
+        handles_t::iterator it = mHandles.find(a->handle());
+
+        if (it != mHandles.end()) {
+            mRunning.erase(it->second);
+            mHandles.erase(it);
+        }
+    }
+
+    virtual bool next()
+    {
+        if (mSelectedActivity == 0) {
+            mSelectedActivityIt = mWaitingActivities.begin();
+        }
+        do {
+            ++mSelectedActivityIt;
+        } while (mSelectedActivityIt != mWaitingActivities.end() and
+                 not admissible(*mSelectedActivityIt));
+        if (mSelectedActivityIt != mWaitingActivities.end()) {
+            mSelectedActivity = *mSelectedActivityIt;
+            return true;
+        } else {
+            mSelectedActivity = 0;
+            return false;
+        }
+    }
+
+    virtual double priority(const Activity* /* a */) const
+    { return 0; }
+
+    virtual void reset()
+    {
+        PriorityPolicy::reset();
+        mReservation = vle::devs::infinity;
+        mMissing.clear();
+    }
+
+    vle::devs::Time reservation() const
+    { return mReservation; }
+
+    virtual void started(const Activity* a, const vle::devs::Time& time)
+    {
+        // the resources the next step keeps are not released
+        Resources resources = a->finishingResources();
+        ResourceTypes types;
+
+        for (Resources::const_iterator it = resources.begin();
+             it != resources.end(); ++it) {
+            ++types[Resources::resource(*it).type()];
+        }
+        finished(a);
+        mHandles[a->handle()] = mRunning.insert(
+            std::make_pair(time + a->current()->duration(), types));
+    }
+
+    virtual void unavailable(const ResourceTypes& missing,
+                             const vle::devs::Time& time)
+    {
+        // only the first activity gets a reservation
+        if (mSelectedActivity != 0) {
+            return;
+        }
+
+        ResourceTypes released;
+
+        mTime = time;
+        mMissing = missing;
+        mReservation = vle::devs::infinity;
+        for (running_t::const_iterator it = mRunning.begin();
+             it != mRunning.end() and mReservation == vle::devs::infinity;
+             ++it) {
+            bool covered = true;
+
+            for (unsigned int type = 0; type < mMissing.size(); ++type) {
+                released[type] += it->second[type];
+                covered = covered and released[type] >= mMissing[type];
+            }
+            if (covered) {
+                mReservation = it->first;
+            }
+        }
+    }
+
+private:
+    bool admissible(const Activity* a) const
+    {
+        if (mTime + a->current()->duration() <= mReservation) {
+            return true;
+        }
+        for (unsigned int type = 0; type < mMissing.size(); ++type) {
+            if (mMissing[type] > 0 and a->demand().quantity(type) > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    running_t mRunning;
+    handles_t mHandles;
+    vle::devs::Time mTime;
+    vle::devs::Time mReservation;
+    ResourceTypes mMissing;
+};
+
+} // namespace rcpsp
+
+#endif
@@ -24,53 +24,23 @@
 #ifndef __FIFO_POLICY_HPP
 #define __FIFO_POLICY_HPP 1
 
-#include <policy/StepSchedulingPolicy.hpp>
+#include <policy/PriorityPolicy.hpp>
 
 namespace rcpsp {
 
-class FIFOPolicy : public StepSchedulingPolicy
+/**
+ * First in, first out: every activity has the same priority, so they are
+ * served in arrival order.
+ */
+class FIFOPolicy : public PriorityPolicy
 {
 public:
     FIFOPolicy(WaitingActivities& waitingActivities) :
-    StepSchedulingPolicy(waitingActivities), mSelectedActivity(0)
+    PriorityPolicy(waitingActivities)
     { }
 
-    virtual void add(Activity* a)
-    { mWaitingActivities.push_back(a); }
-
-    virtual bool another() const
-    { return true; }
-
-    virtual bool demand() const
-    { return false; }
-
-    virtual bool next()
-    {
-        if (mSelectedActivity == 0) {
-            mSelectedActivityIt = mWaitingActivities.begin();
-        }
-        ++mSelectedActivityIt;
-        if (mSelectedActivityIt != mWaitingActivities.end()) {
-            mSelectedActivity = *mSelectedActivityIt;
-            return true;
-        } else {
-            mSelectedActivity = 0;
-            return false;
-        }
-    }
-
-    virtual void reset()
-    { mSelectedActivity = 0; }
-
-    virtual Activity* select() const
-    {
-        return mSelectedActivity == 0 ? mWaitingActivities.front() :
-            mSelectedActivity;
-    }
-
-private:
-    WaitingActivities::iterator mSelectedActivityIt;
-    Activity* mSelectedActivity;
+    virtual double priority(const Activity* /* a */) const
+    { return 0; }
 };
 
 } // namespace rcpsp
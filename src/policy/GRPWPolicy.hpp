@@ -0,0 +1,49 @@
+/**
+ * @file GRPWPolicy.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GRPW_POLICY_HPP
+#define __GRPW_POLICY_HPP 1
+
+#include <policy/PriorityPolicy.hpp>
+
+namespace rcpsp {
+
+/**
+ * Greatest rank positional weight: the activity with the largest duration
+ * of work left, its own from the current step and the one of all its
+ * successors in the precedence graph, first.
+ */
+class GRPWPolicy : public PriorityPolicy
+{
+public:
+    GRPWPolicy(WaitingActivities& waitingActivities) :
+    PriorityPolicy(waitingActivities)
+    { }
+
+    virtual double priority(const Activity* a) const
+    { return -(a->remainingWork() + a->successorsWork()); }
+};
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file LFTPolicy.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LFT_POLICY_HPP
+#define __LFT_POLICY_HPP 1
+
+#include <policy/DueDatePolicy.hpp>
+#include <policy/EDDPolicy.hpp>
+
+namespace rcpsp {
+
+/**
+ * The late finish time of the current step, or the one of the activity if
+ * the step has none.
+ */
+struct StepFinishKey
+{
+    static bool due(const Activity* a, vle::devs::Time& date)
+    {
+        const TemporalConstraints& tc = a->current()->temporalConstraints();
+
+        if (tc.isLF()) {
+            date = tc.lateFinishTime();
+            return true;
+        }
+        return ActivityFinishKey::due(a, date);
+    }
+};
+
+/**
+ * Latest finish time: the activity whose current step must finish the
+ * earliest first, the activities without any late finish time last.
+ */
+typedef DueDatePolicy < StepFinishKey > LFTPolicy;
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file MinSlackPolicy.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MIN_SLACK_POLICY_HPP
+#define __MIN_SLACK_POLICY_HPP 1
+
+#include <policy/DueDatePolicy.hpp>
+#include <policy/EDDPolicy.hpp>
+
+namespace rcpsp {
+
+/** The latest start of the remaining work of the activity. */
+struct LatestStartKey
+{
+    static bool due(const Activity* a, vle::devs::Time& date)
+    {
+        if (ActivityFinishKey::due(a, date)) {
+            date -= a->remainingWork();
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * Minimum slack: the activity which must start its remaining work the
+ * earliest to meet its late finish time first. At a given time the slack
+ * is this latest start minus the time, so the order is the same. The
+ * activities without a late finish time come last.
+ */
+typedef DueDatePolicy < LatestStartKey > MinSlackPolicy;
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file Policies.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __POLICIES_HPP
+#define __POLICIES_HPP 1
+
+#include <string>
+
+#include <policy/BackfillingPolicy.hpp>
+#include <policy/EDDPolicy.hpp>
+#include <policy/FIFOPolicy.hpp>
+#include <policy/GRPWPolicy.hpp>
+#include <policy/LFTPolicy.hpp>
+#include <policy/MinSlackPolicy.hpp>
+#include <policy/MTSPolicy.hpp>
+#include <policy/SPTPolicy.hpp>
+
+namespace rcpsp {
+
+/**
+ * Build the step scheduling policy of the given name: FIFO, SPT, LFT,
+ * MTS, GRPW, MinSlack, EDD or Backfilling. Return 0 for an unknown name.
+ */
+inline StepSchedulingPolicy* buildPolicy(const std::string& name,
+                                         WaitingActivities& waitingActivities)
+{
+    if (name == "FIFO") {
+        return new FIFOPolicy(waitingActivities);
+    } else if (name == "SPT") {
+        return new SPTPolicy(waitingActivities);
+    } else if (name == "LFT") {
+        return new LFTPolicy(waitingActivities);
+    } else if (name == "MTS") {
+        return new MTSPolicy(waitingActivities);
+    } else if (name == "GRPW") {
+        return new GRPWPolicy(waitingActivities);
+    } else if (name == "MinSlack") {
+        return new MinSlackPolicy(waitingActivities);
+    } else if (name == "EDD") {
+        return new EDDPolicy(waitingActivities);
+    } else if (name == "Backfilling") {
+        return new BackfillingPolicy(waitingActivities);
+    }
+    return 0;
+}
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file PriorityPolicy.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PRIORITY_POLICY_HPP
+#define __PRIORITY_POLICY_HPP 1
+
+#include <policy/StepSchedulingPolicy.hpp>
+
+namespace rcpsp {
+
+/**
+ * Serve the waiting activities by increasing priority: the first one is
+ * selected and, when its resources are unavailable, the next ones are
+ * tried in turn.
+ */
+class PriorityPolicy : public StepSchedulingPolicy
+{
+public:
+    PriorityPolicy(WaitingActivities& waitingActivities) :
+    StepSchedulingPolicy(waitingActivities), mSelectedActivity(0)
+    { }
+
+    virtual bool another() const
+    { return true; }
+
+    virtual bool demand() const
+    { return false; }
+
+    virtual bool next()
+    {
+        if (mSelectedActivity == 0) {
+            mSelectedActivityIt = mWaitingActivities.begin();
+        }
+        ++mSelectedActivityIt;
+        if (mSelectedActivityIt != mWaitingActivities.end()) {
+            mSelectedActivity = *mSelectedActivityIt;
+            return true;
+        } else {
+            mSelectedActivity = 0;
+            return false;
+        }
+    }
+
+    virtual void reset()
+    { mSelectedActivity = 0; }
+
+    virtual Activity* select() const
+    {
+        return mSelectedActivity == 0 ? mWaitingActivities.front() :
+            mSelectedActivity;
+    }
+
+protected:
+    WaitingActivities::const_iterator mSelectedActivityIt;
+    Activity* mSelectedActivity;
+};
+
+} // namespace rcpsp
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file RuntimePolicy.hpp
+ * @author The VLE Development Team
+ * See the AUTHORS or Authors.txt file
+ */
+
+/*
+ * Copyright (C) 2012-2014 ULCO http://www.univ-littoral.fr
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RUNTIME_POLICY_HPP
+#define __RUNTIME_POLICY_HPP 1
+
+#include <string>
+
+#include <vle/utils/Exception.hpp>
+
+#include <policy/Policies.hpp>
+
+namespace rcpsp {
+
+/**
+ * The policy named by the "policy" port of the condition (FIFO by
+ * default), called through the StepSchedulingPolicy interface. It is the
+ * pluggable path for the policies without a dedicated model.
+ */
+class RuntimePolicy : public StepSchedulingPolicy
+{
+public:
+    RuntimePolicy(WaitingActivities& waitingActivities) :
+    StepSchedulingPolicy(waitingActivities), mPolicy(0)
+    { }
+
+    virtual ~RuntimePolicy()
+    { delete mPolicy; }
+
+    virtual bool another() const
+    { return mPolicy->another(); }
+
+    virtual void configure(const vle::devs::InitEventList& events)
+    {
+        std::string name = "FIFO";
+
+        if (events.exist("policy")) {
+            name = vle::value::toString(events.get("policy"));
+        }
+        delete mPolicy;
+        mPolicy = buildPolicy(name, mWaitingActivities);
+        if (mPolicy == 0) {
+            throw vle::utils::ModellingError(
+                "unknown step scheduling policy: " + name);
+        }
+        mPolicy->configure(events);
+    }
+
+    virtual bool demand() const
+    { return mPolicy->demand(); }
+
+    virtual void finished(const Activity* a)
+    { mPolicy->finished(a); }
+
+    virtual bool next()
+    { return mPolicy->next(); }
+
+    virtual double priority(const Activity* a) const
+    { return mPolicy->priority(a); }
+
+    virtual void reset()
+    { mPolicy->reset(); }
+
+    virtual Activity* select() const
+    { return mPolicy->select(); }
+
+    virtual void started(const Activity* a, const vle::devs::Time& time)
+    { mPolicy->started(a, time); }
+
+    virtual void unavailable(const ResourceTypes& missing,
+                             const vle::devs::Time& time)
+    { mPolicy->unavailable(missing, time); }
+
+private:
+    StepSchedulingPolicy* mPolicy;
+};
+
+} // namespace rcpsp
+
+#endif
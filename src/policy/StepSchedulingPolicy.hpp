@@ -24,10 +24,12 @@
 #ifndef __STEP_SCHEDULING_POLICY_HPP
 #define __STEP_SCHEDULING_POLICY_HPP 1
 
-namespace rcpsp {
+#include <vle/devs/Dynamics.hpp>
 
 #include <data/Activities.hpp>
 
+namespace rcpsp {
+
 class StepSchedulingPolicy
 {
 public:
@@ -35,13 +37,56 @@ public:
     mWaitingActivities(waitingActivities)
     { }
 
-    virtual void add(Activity* a) =0;
+    virtual ~StepSchedulingPolicy()
+    { }
+
+    /**
+     * Queue an activity with the priority given by the policy.
+     */
+    void add(Activity* a)
+    { mWaitingActivities.push(a, priority(a)); }
+
     virtual bool another() const =0;
+
+    /**
+     * Read the parameters of the policy from the condition of the model,
+     * none by default.
+     */
+    virtual void configure(const vle::devs::InitEventList& /* events */)
+    { }
+
     virtual bool demand() const =0;
+
+    /**
+     * The step of an activity has been sent to the processor at time,
+     * respectively has ended; nothing to do by default.
+     */
+    virtual void started(const Activity* /* a */,
+                         const vle::devs::Time& /* time */)
+    { }
+
+    virtual void finished(const Activity* /* a */)
+    { }
+
     virtual bool next() =0;
+
+    /**
+     * The priority of an activity, the lowest is served first and the
+     * activities of equal priority in arrival order.
+     */
+    virtual double priority(const Activity* a) const =0;
+
     virtual void reset() =0;
     virtual Activity* select() const =0;
 
+    /**
+     * The selected activity cannot get its resources at time, missing
+     * the given quantities; nothing to do by default.
+     */
+    virtual void unavailable(const ResourceTypes& /* missing */,
+                             const vle::devs::Time& /* time */)
+    { }
+
 protected:
     WaitingActivities& mWaitingActivities;
 };
@@ -30,7 +30,21 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <data/Activity.hpp>
+#include <data/ActivityStore.hpp>
+#include <data/CriticalPath.hpp>
+#include <data/FinishCalendar.hpp>
+#include <data/FreeResources.hpp>
+#include <data/PrecedencesGraph.hpp>
+#include <data/ReleaseCalendar.hpp>
+#include <data/ResourceBank.hpp>
 #include <data/ResourcePool.hpp>
+#include <data/Run.hpp>
+#include <data/Time.hpp>
+#include <data/TransitCalendar.hpp>
+#include <policy/Policies.hpp>
+#include <policy/RuntimePolicy.hpp>
+
+#include <algorithm>
 
 using namespace rcpsp;
 
@@ -42,6 +56,17 @@ BOOST_AUTO_TEST_CASE(test_activity)
                                           vle::devs::infinity,
                                           vle::devs::negativeInfinity,
                                           vle::devs::infinity));
+    ResourceConstraints resourceConstraints;
+
+    activity.addStep(new Step("A1_1", 0.1, Location("L1"),
+                              resourceConstraints,
+                              activity.temporalConstraints()));
+    activity.wait(0.7);
+    activity.start(0.7);
+
+    // 0.7 + 0.1 - 0.7 < 0.1 with doubles
+    BOOST_CHECK(not activity.done(0.75));
+    BOOST_CHECK(activity.done(0.7 + 0.1));
 }
 
 BOOST_AUTO_TEST_CASE(test_step)
@@ -50,20 +75,20 @@ BOOST_AUTO_TEST_CASE(test_step)
     Location L2("L2");
     Location L3("L3");
 
-    ResourcePool Pool1("R1");
-    Pool1.add(new Resource("R1", "R1_1"));
-    Pool1.add(new Resource("R1", "R1_2"));
-    Pool1.add(new Resource("R1", "R1_3"));
+    ResourcePool Pool1("R1", "R1");
+    Pool1.add(ResourceRegistry::add("R1_1", "R1"));
+    Pool1.add(ResourceRegistry::add("R1_2", "R1"));
+    Pool1.add(ResourceRegistry::add("R1_3", "R1"));
 
-    ResourcePool Pool2("R2");
-    Pool2.add(new Resource("R2", "R2_1"));
-    Pool2.add(new Resource("R2", "R2_2"));
-    Pool2.add(new Resource("R2", "R2_3"));
+    ResourcePool Pool2("R2", "R2");
+    Pool2.add(ResourceRegistry::add("R2_1", "R2"));
+    Pool2.add(ResourceRegistry::add("R2_2", "R2"));
+    Pool2.add(ResourceRegistry::add("R2_3", "R2"));
 
-    ResourcePool Pool3("R3");
-    Pool3.add(new Resource("R3", "R3_1"));
-    Pool3.add(new Resource("R3", "R3_2"));
-    Pool3.add(new Resource("R3", "R3_3"));
+    ResourcePool Pool3("R3", "R3");
+    Pool3.add(ResourceRegistry::add("R3_1", "R3"));
+    Pool3.add(ResourceRegistry::add("R3_2", "R3"));
+    Pool3.add(ResourceRegistry::add("R3_3", "R3"));
 
     ResourceConstraints resourceConstraints;
 
@@ -77,3 +102,905 @@ BOOST_AUTO_TEST_CASE(test_step)
                                   vle::devs::negativeInfinity,
                                   vle::devs::infinity));
 }
+
+BOOST_AUTO_TEST_CASE(test_activity_store)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    ResourceConstraints resourceConstraints;
+
+    resourceConstraints.push_back(ResourceConstraint("R1", 1, false));
+
+    Activities activities;
+    Activity* activity = new Activity("A1", tc);
+
+    activity->addStep(new Step("A1_1", 10, Location("L1"),
+                               resourceConstraints, tc));
+    activity->addStep(new Step("A1_2", 5, Location("L2"),
+                               resourceConstraints, tc));
+    activities.push_back(activity);
+
+    ActivityStore store(activities);
+
+    activity->wait(0);
+    activity->finish(10);
+
+    vle::value::Value* value = activity->toEventValue();
+
+    BOOST_REQUIRE(ActivityStore::isHandle(*value));
+
+    Activity* copy = Activity::build(*value);
+
+    BOOST_CHECK_EQUAL(copy->name(), "A1");
+    BOOST_CHECK_EQUAL(copy->current()->name(), "A1_2");
+    BOOST_CHECK_EQUAL(copy->location().name(), "L2");
+    BOOST_CHECK(copy->store() == &store);
+    BOOST_CHECK(copy->current() == activity->current());
+    delete copy;
+    delete value;
+
+    value = activity->toValue();
+
+    Activity full(value);
+
+    BOOST_CHECK_EQUAL(full.current()->name(), "A1_2");
+    delete value;
+
+    value = full.toEventValue();
+    BOOST_REQUIRE(Blob::isBlob(*value));
+    BOOST_CHECK(not ActivityStore::isHandle(*value));
+    copy = Activity::build(*value);
+    BOOST_CHECK_EQUAL(copy->current()->name(), "A1_2");
+    BOOST_CHECK_EQUAL(copy->location().name(), "L2");
+    BOOST_CHECK_EQUAL(copy->current()->duration(), 5);
+    delete copy;
+    delete value;
+}
+
+BOOST_AUTO_TEST_CASE(test_blob)
+{
+    Blob blob;
+
+    blob.putInteger(10);
+    blob.putBoolean(true);
+
+    Blob::Reader reader(blob);
+
+    // the string would end past the data
+    BOOST_CHECK_THROW(reader.getString(), vle::utils::ModellingError);
+
+    Blob::Reader values(blob);
+
+    BOOST_CHECK_EQUAL(values.getInteger(), 10u);
+    BOOST_CHECK(values.getBoolean());
+    BOOST_CHECK_THROW(values.getDouble(), vle::utils::ModellingError);
+}
+
+BOOST_AUTO_TEST_CASE(test_precedences_graph)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    Activities activities;
+
+    activities.push_back(new Activity("A1", tc));
+    activities.push_back(new Activity("A2", tc));
+    activities.push_back(new Activity("A3", tc));
+
+    vle::value::Set precedences;
+    vle::value::Set* fs = new vle::value::Set;
+    vle::value::Set* ss = new vle::value::Set;
+
+    fs->add(new vle::value::String("A1"));
+    fs->add(new vle::value::String("A3"));
+    fs->add(new vle::value::String("FS"));
+    ss->add(new vle::value::String("A2"));
+    ss->add(new vle::value::String("A3"));
+    ss->add(new vle::value::String("SS"));
+    ss->add(new vle::value::Double(5));
+    precedences.add(fs);
+    precedences.add(ss);
+
+    PrecedencesGraph graph(&precedences, activities);
+    PrecedencesGraph::result_t ready;
+
+    BOOST_CHECK(graph.ready(0));
+    BOOST_CHECK(graph.ready(1));
+    BOOST_CHECK(not graph.ready(2));
+    graph.started(0, 0, ready);
+    graph.started(1, 2, ready);
+    BOOST_CHECK(ready.empty());
+    BOOST_CHECK(not graph.ready(2));
+    graph.finished(0, 4, ready);
+    BOOST_REQUIRE_EQUAL(ready.size(), 1u);
+    BOOST_CHECK_EQUAL(ready.front(), 2u);
+    BOOST_CHECK_CLOSE(graph.release(2), 7., 1e-9);
+
+    // the successor of a FF constraint may start before the lag by the
+    // duration of its work
+    ResourceConstraints resourceConstraints;
+    Activities steps;
+
+    steps.push_back(new Activity("B1", tc));
+    steps.push_back(new Activity("B2", tc));
+    steps[0]->addStep(new Step("B1_1", 4, Location("L1"),
+                               resourceConstraints, tc));
+    steps[1]->addStep(new Step("B2_1", 3, Location("L1"),
+                               resourceConstraints, tc));
+
+    vle::value::Set ff;
+    vle::value::Set* constraint = new vle::value::Set;
+
+    constraint->add(new vle::value::String("B1"));
+    constraint->add(new vle::value::String("B2"));
+    constraint->add(new vle::value::String("FF"));
+    constraint->add(new vle::value::Double(2));
+    ff.add(constraint);
+
+    PrecedencesGraph finish(&ff, steps);
+
+    ready.clear();
+    finish.started(0, 0, ready);
+    BOOST_CHECK(ready.empty());
+    finish.finished(0, 4, ready);
+    BOOST_REQUIRE_EQUAL(ready.size(), 1u);
+    BOOST_CHECK_CLOSE(finish.release(1), 3., 1e-9);
+
+    // the successors and their work rank the activities
+    finish.rank(steps);
+    BOOST_CHECK_EQUAL(steps[0]->successors(), 1u);
+    BOOST_CHECK_CLOSE(steps[0]->successorsWork(), 3., 1e-9);
+    BOOST_CHECK_EQUAL(steps[1]->successors(), 0u);
+    graph.rank(activities);
+    BOOST_CHECK_EQUAL(activities[0]->successors(), 1u);
+    BOOST_CHECK_EQUAL(activities[2]->successors(), 0u);
+
+    // a maximal time lag cannot be kept by the scheduler
+    constraint->add(new vle::value::Double(3));
+    BOOST_CHECK_THROW(PrecedencesGraph(&ff, steps),
+                      vle::utils::ModellingError);
+}
+
+BOOST_AUTO_TEST_CASE(test_critical_path)
+{
+    PrecedencesGraph graph;
+    std::vector < vle::devs::Time > durations;
+
+    durations.push_back(3);
+    durations.push_back(2);
+    durations.push_back(4);
+    durations.push_back(1);
+    graph.add(0, 2, PrecedenceConstraint::FS, 1, vle::devs::infinity);
+    graph.add(1, 2, PrecedenceConstraint::SS, 5, vle::devs::infinity);
+    graph.add(2, 3, PrecedenceConstraint::FF, 0, vle::devs::infinity);
+
+    CriticalPath cpm(graph, durations);
+
+    BOOST_CHECK_CLOSE(cpm.makespan(), 9., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.earlyStartTime(2), 5., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.earlyStartTime(3), 8., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.lateStartTime(0), 1., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.lateFinishTime(2), 9., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.totalSlack(0), 1., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.freeSlack(0), 1., 1e-9);
+    BOOST_CHECK(cpm.critical(1));
+    BOOST_CHECK(not cpm.critical(0));
+
+    cpm.duration(0, 5);
+    BOOST_CHECK_CLOSE(cpm.makespan(), 10., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.earlyStartTime(2), 6., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.earlyStartTime(3), 9., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.lateStartTime(1), 1., 1e-9);
+    BOOST_CHECK(cpm.critical(0));
+
+    cpm.duration(1, 1);
+    BOOST_CHECK_CLOSE(cpm.makespan(), 10., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.lateStartTime(1), 1., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.totalSlack(1), 1., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_critical_path_apply)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    TemporalConstraints window((TemporalConstraints::Type)
+                               (TemporalConstraints::ES |
+                                TemporalConstraints::LS),
+                               10, 12, vle::devs::negativeInfinity,
+                               vle::devs::infinity);
+    ResourceConstraints resourceConstraints;
+    Activities activities;
+    PrecedencesGraph graph;
+
+    activities.push_back(new Activity("A1", window));
+    activities.push_back(new Activity("A2", tc));
+    activities.push_back(new Activity("A3", tc));
+    activities[0]->addStep(new Step("A1_1", 3, Location("L1"),
+                                    resourceConstraints, tc));
+    activities[1]->addStep(new Step("A2_1", 2, Location("L1"),
+                                    resourceConstraints, tc));
+    activities[2]->addStep(new Step("A3_1", 4, Location("L1"),
+                                    resourceConstraints, tc));
+    graph.add(0, 2, PrecedenceConstraint::FS, 0, vle::devs::infinity);
+    graph.add(1, 2, PrecedenceConstraint::FS, 0, vle::devs::infinity);
+
+    // the forward pass starts from the entered early start of A1
+    CriticalPath cpm(graph, activities);
+
+    BOOST_CHECK_CLOSE(cpm.earlyStartTime(2), 13., 1e-9);
+    BOOST_CHECK_CLOSE(cpm.makespan(), 17., 1e-9);
+
+    // the "critical path" port of the activity scheduler applies it
+    vle::value::Map events;
+
+    CriticalPath::configure(events, graph, activities);
+    BOOST_CHECK(not activities[1]->temporalConstraints().isLF());
+    events.add("critical path", new vle::value::Boolean(true));
+    CriticalPath::configure(events, graph, activities);
+
+    // the entered window is kept and every activity gets a late finish
+    const TemporalConstraints& tc1 = activities[0]->temporalConstraints();
+    const TemporalConstraints& tc2 = activities[1]->temporalConstraints();
+
+    BOOST_CHECK(tc1.isES() and tc1.isLS() and tc1.isLF());
+    BOOST_CHECK_CLOSE(tc1.earlyStartTime(), 10., 1e-9);
+    BOOST_CHECK_CLOSE(tc1.lateStartTime(), 12., 1e-9);
+    BOOST_CHECK_CLOSE(tc1.lateFinishTime(), 13., 1e-9);
+    BOOST_CHECK(not tc2.isES() and tc2.isLF());
+    BOOST_CHECK_CLOSE(tc2.lateFinishTime(), 13., 1e-9);
+    BOOST_CHECK_CLOSE(activities[2]->temporalConstraints().lateFinishTime(),
+                      17., 1e-9);
+
+    // a shorter activity on the critical path shortens the makespan
+    cpm.duration(2, 1);
+    BOOST_CHECK_CLOSE(cpm.makespan(), 14., 1e-9);
+    cpm.duration(1, 20);
+    BOOST_CHECK_CLOSE(cpm.makespan(), 21., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_release_calendar)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    TemporalConstraints window((TemporalConstraints::Type)
+                               (TemporalConstraints::ES |
+                                TemporalConstraints::LS),
+                               10, 12, vle::devs::negativeInfinity,
+                               vle::devs::infinity);
+    ResourceConstraints resourceConstraints;
+    ReleaseCalendar calendar;
+    Activity* a1 = new Activity("A1", window);
+    Activity* a2 = new Activity("A2", tc);
+    Activity* a3 = new Activity("A3", window);
+
+    a1->addStep(new Step("A1_1", 1, Location("L1"), resourceConstraints, tc));
+    a2->addStep(new Step("A2_1", 1, Location("L1"), resourceConstraints, tc));
+    a3->addStep(new Step("A3_1", 1, Location("L1"), resourceConstraints, tc));
+    calendar.push(a1);
+    calendar.push(a2, 5);
+    calendar.push(a3, 15);
+
+    BOOST_CHECK_CLOSE(calendar.next(0), 5., 1e-9);
+    calendar.starting(5);
+    BOOST_REQUIRE_EQUAL(calendar.startingActivities().size(), 1u);
+    BOOST_CHECK(calendar.startingActivities().front() == a2);
+    calendar.removeStartingActivities();
+    delete a2;
+    BOOST_CHECK_CLOSE(calendar.next(5), 5., 1e-9);
+    calendar.starting(10);
+    BOOST_REQUIRE_EQUAL(calendar.startingActivities().size(), 1u);
+    BOOST_CHECK(calendar.startingActivities().front() == a1);
+    calendar.removeStartingActivities();
+    delete a1;
+
+    // the window of A3 is closed when its predecessors release it: it
+    // starts late and is flagged
+    calendar.starting(15);
+    BOOST_REQUIRE_EQUAL(calendar.startingActivities().size(), 1u);
+    BOOST_CHECK(calendar.startingActivities().front() == a3);
+    BOOST_REQUIRE_EQUAL(calendar.lateActivities().size(), 1u);
+    BOOST_CHECK(calendar.lateActivities().front() == a3);
+    calendar.removeStartingActivities();
+    BOOST_CHECK(calendar.lateActivities().empty());
+    BOOST_CHECK(calendar.empty());
+    delete a3;
+
+    // a release date summed from durations is reached up to the rounding
+    Activity* a4 = new Activity("A4", tc);
+
+    a4->addStep(new Step("A4_1", 1, Location("L1"), resourceConstraints, tc));
+    calendar.push(a4, 0.1 + 0.2);
+    calendar.starting(0.3);
+    BOOST_REQUIRE_EQUAL(calendar.startingActivities().size(), 1u);
+    calendar.removeStartingActivities();
+    delete a4;
+}
+
+BOOST_AUTO_TEST_CASE(test_transit_calendar)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    TransitCalendar calendar;
+
+    BOOST_CHECK_EQUAL(calendar.next(0), vle::devs::infinity);
+    calendar.push(new Activity("A1", tc), 0.1 + 0.2);
+    calendar.push(new Activity("A2", tc), 1);
+    BOOST_CHECK_CLOSE(calendar.next(0.1), 0.2, 1e-9);
+    BOOST_CHECK_EQUAL(calendar.begin()->second->name(), "A1");
+
+    // an out date computed by sums is out at the rounded time
+    BOOST_CHECK(reached(0.1 + 0.2, 0.3));
+    BOOST_CHECK(not reached(1, 0.3));
+    calendar.removeArrived(0.3);
+    BOOST_REQUIRE_EQUAL(calendar.size(), 1u);
+    BOOST_CHECK_EQUAL(calendar.begin()->second->name(), "A2");
+    BOOST_CHECK_CLOSE(calendar.next(0.3), 0.7, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_finish_calendar)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    ResourceConstraints resourceConstraints;
+    Activities running;
+    Activities done;
+    FinishCalendar calendar(running);
+    Activity* a1 = new Activity("A1", tc);
+    Activity* a2 = new Activity("A2", tc);
+    Activity* a3 = new Activity("A3", tc);
+
+    a1->addStep(new Step("A1_1", 0.3, Location("L1"), resourceConstraints,
+                         tc));
+    a2->addStep(new Step("A2_1", 0.2, Location("L1"), resourceConstraints,
+                         tc));
+    a3->addStep(new Step("A3_1", 1, Location("L1"), resourceConstraints, tc));
+    a1->wait(0);
+    a2->wait(0);
+    a3->wait(0);
+
+    BOOST_CHECK_EQUAL(calendar.next(0), vle::devs::infinity);
+    calendar.start(0, a1);
+    calendar.start(0, a3);
+    calendar.start(0.1, a2);
+    BOOST_CHECK_EQUAL(running.size(), 3u);
+    BOOST_CHECK_CLOSE(calendar.next(0.1), 0.2, 1e-9);
+
+    // A1 and A2 end at the same date up to the rounding: one batch
+    calendar.finish(0.3, done);
+    BOOST_REQUIRE_EQUAL(done.size(), 2u);
+    BOOST_CHECK(std::find(done.begin(), done.end(), a1) != done.end());
+    BOOST_CHECK(std::find(done.begin(), done.end(), a2) != done.end());
+    BOOST_REQUIRE_EQUAL(running.size(), 1u);
+    BOOST_CHECK_EQUAL(running.front(), a3);
+    BOOST_CHECK_CLOSE(calendar.next(0.3), 0.7, 1e-9);
+
+    calendar.finish(1, done);
+    BOOST_CHECK_EQUAL(done.size(), 3u);
+    BOOST_CHECK(running.empty());
+    BOOST_CHECK(calendar.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_resource_demand)
+{
+    ResourceConstraints resourceConstraints;
+
+    resourceConstraints.push_back(ResourceConstraint("R1", 2, false));
+    resourceConstraints.push_back(ResourceConstraint("R2", 1, false));
+
+    ResourceDemand demand;
+    Resources resources;
+    unsigned int r1 = ResourceRegistry::add("R1_1", "R1");
+    unsigned int r2 = ResourceRegistry::add("R1_2", "R1");
+    unsigned int r3 = ResourceRegistry::add("R2_1", "R2");
+    unsigned int type1 = ResourceRegistry::get(r1).type();
+    unsigned int type2 = ResourceRegistry::get(r3).type();
+
+    demand.reset(resourceConstraints, 0);
+    BOOST_CHECK_EQUAL(demand.quantity(), 3u);
+    BOOST_CHECK_EQUAL(demand.size(), 2u);
+
+    resources.insert(r1);
+    demand.assign(resources);
+    BOOST_CHECK_EQUAL(demand.quantity(type1), 1u);
+    BOOST_CHECK_EQUAL(demand.quantity(), 2u);
+
+    resources.clear();
+    resources.insert(r2);
+    resources.insert(r3);
+    demand.assign(resources);
+    BOOST_CHECK(demand.empty());
+
+    demand.reset(resourceConstraints, &resources);
+    BOOST_CHECK_EQUAL(demand.quantity(type1), 1u);
+    BOOST_CHECK_EQUAL(demand.quantity(type2), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_resource_pool)
+{
+    ResourcePool pool("P", "P");
+
+    pool.add(ResourceRegistry::add("P_1", "P"));
+    pool.add(ResourceRegistry::add("P_2", "P"));
+    pool.add(ResourceRegistry::add("P_3", "P"));
+
+    Resources taken = pool.assign(2);
+
+    BOOST_CHECK_EQUAL(taken.size(), 2u);
+    BOOST_CHECK_EQUAL(pool.quantity(), 1);
+
+    // only the resources of the type of the pool come back
+    Resources released(taken);
+
+    released.insert(ResourceRegistry::add("Q_1", "Q"));
+    pool.release(released);
+    BOOST_CHECK_EQUAL(pool.quantity(), 3);
+    BOOST_CHECK(pool.available().contains(*taken.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(test_resource_bank)
+{
+    ResourceConstraints resourceConstraints;
+
+    resourceConstraints.push_back(ResourceConstraint("R1", 2, false));
+    resourceConstraints.push_back(ResourceConstraint("R2", 1, false));
+
+    ResourceBank bank;
+    ResourceDemand demand;
+    Resources pool;
+    Resources granted;
+    ResourceTypes missing;
+    unsigned int r1 = ResourceRegistry::add("R1_1", "R1");
+    unsigned int r3 = ResourceRegistry::add("R2_1", "R2");
+    unsigned int type1 = ResourceRegistry::get(r1).type();
+    unsigned int type2 = ResourceRegistry::get(r3).type();
+
+    pool.insert(r1);
+    pool.insert(r3);
+    bank.add(pool);
+    demand.reset(resourceConstraints, 0);
+
+    // nothing is taken when a type is short
+    BOOST_CHECK(not bank.reserve(demand, granted, missing));
+    BOOST_CHECK(granted.empty());
+    BOOST_CHECK_EQUAL(missing[type1], 1u);
+    BOOST_CHECK_EQUAL(missing[type2], 0u);
+    BOOST_CHECK_EQUAL(bank.quantity(type1), 1u);
+
+    // a free resource is not counted twice
+    bank.release(pool.ofType(type1));
+    BOOST_CHECK_EQUAL(bank.quantity(type1), 1u);
+    pool.clear();
+    pool.insert(ResourceRegistry::add("R1_2", "R1"));
+    bank.release(pool);
+    BOOST_CHECK(bank.reserve(demand, granted, missing));
+    BOOST_CHECK_EQUAL(granted.size(), 3u);
+    BOOST_CHECK_EQUAL(bank.quantity(type1), 0u);
+    BOOST_CHECK_EQUAL(bank.quantity(type2), 0u);
+
+    bank.release(granted);
+    BOOST_CHECK_EQUAL(bank.quantity(type1), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(test_resource_bank_pools)
+{
+    ResourceConstraints resourceConstraints;
+
+    resourceConstraints.push_back(ResourceConstraint("B1", 3, false));
+    resourceConstraints.push_back(ResourceConstraint("B2", 1, false));
+
+    // two pools of the same type are merged
+    vle::value::Set pools;
+
+    for (unsigned int i = 0; i < 3; ++i) {
+        vle::value::Set* pool = new vle::value::Set;
+        vle::value::Set* resources = new vle::value::Set;
+        vle::value::Set* resource = new vle::value::Set;
+        std::string type = i < 2 ? "B1" : "B2";
+
+        resource->add(new vle::value::String(type + "_" +
+                                             (char)('1' + i)));
+        resource->add(new vle::value::String(type));
+        resources->add(resource);
+        pool->add(new vle::value::String("P" + type));
+        pool->add(new vle::value::String(type));
+        pool->add(resources);
+        pools.add(pool);
+    }
+
+    ResourceBank bank(&pools);
+    ResourceDemand demand;
+    Resources granted;
+    ResourceTypes missing;
+    unsigned int type1 = Symbols::resourceTypes().id("B1");
+    unsigned int type2 = Symbols::resourceTypes().id("B2");
+
+    BOOST_CHECK_EQUAL(bank.quantity(type1), 2u);
+    BOOST_CHECK_EQUAL(bank.quantity(type2), 1u);
+
+    // the whole demand travels in one event value
+    demand.reset(resourceConstraints, 0);
+
+    vle::value::Value* value = demand.toEventValue();
+    ResourceDemand* sent = ResourceDemand::build(*value);
+
+    delete value;
+    BOOST_CHECK(not bank.reserve(*sent, granted, missing));
+    BOOST_CHECK(granted.empty());
+    BOOST_CHECK_EQUAL(missing[type1], 1u);
+    BOOST_CHECK_EQUAL(bank.quantity(type2), 1u);
+    delete sent;
+
+    resourceConstraints[0] = ResourceConstraint("B1", 2, false);
+    demand.reset(resourceConstraints, 0);
+    missing.clear();
+    BOOST_CHECK(bank.reserve(demand, granted, missing));
+    BOOST_CHECK_EQUAL(granted.size(), 3u);
+    BOOST_CHECK_EQUAL(bank.quantity(type1), 0u);
+    BOOST_CHECK_EQUAL(bank.quantity(type2), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_free_resources)
+{
+    ResourceConstraints resourceConstraints;
+
+    resourceConstraints.push_back(ResourceConstraint("R1", 2, false));
+    resourceConstraints.push_back(ResourceConstraint("R2", 1, false));
+
+    FreeResources free;
+    ResourceDemand demand;
+    ResourceTypes missing;
+    ResourceTypes released;
+    Resources assigned;
+    unsigned int r1 = ResourceRegistry::add("R1_1", "R1");
+    unsigned int type1 = ResourceRegistry::get(r1).type();
+    unsigned int type2 = ResourceRegistry::get(
+        ResourceRegistry::add("R2_1", "R2")).type();
+
+    // nothing is known before a refusal
+    demand.reset(resourceConstraints, 0);
+    BOOST_CHECK(free.satisfiable(demand));
+
+    // one R1 is free, R2 is not limited
+    missing[type1] = 1;
+    free.refused(demand, missing);
+    BOOST_CHECK(not free.satisfiable(demand));
+
+    // a release of another type does not help
+    released[type2] = 3;
+    free.released(released);
+    BOOST_CHECK(not free.satisfiable(demand));
+
+    released[type1] = 1;
+    free.released(released);
+    BOOST_CHECK(free.satisfiable(demand));
+
+    // an assigned resource is not free any more
+    assigned.insert(r1);
+    free.assigned(assigned);
+    BOOST_CHECK(not free.satisfiable(demand));
+}
+
+BOOST_AUTO_TEST_CASE(test_resources)
+{
+    Resources all;
+
+    all.insert(ResourceRegistry::add("P1_1", "P1"));
+    all.insert(ResourceRegistry::add("P1_2", "P1"));
+    all.insert(ResourceRegistry::add("P1_3", "P1"));
+    all.insert(ResourceRegistry::add("P2_0", "P2"));
+
+    unsigned int type1 = Symbols::resourceTypes().id("P1");
+    unsigned int type2 = Symbols::resourceTypes().id("P2");
+
+    // a name is bound to its type
+    BOOST_CHECK_EQUAL(ResourceRegistry::add("P1_1", "P1"), *all.begin());
+    BOOST_CHECK_THROW(ResourceRegistry::add("P1_1", "P2"),
+                      vle::utils::ModellingError);
+
+    BOOST_CHECK_EQUAL(all.size(), 4u);
+    BOOST_CHECK_EQUAL(all.count(type1), 3u);
+    BOOST_CHECK_EQUAL(all.count(type2), 1u);
+
+    Resources two = all.ofType(type1).first(2);
+
+    BOOST_CHECK_EQUAL(two.size(), 2u);
+    all.remove(two);
+    BOOST_CHECK_EQUAL(all.count(type1), 1u);
+    BOOST_CHECK(not all.contains(*two.begin()));
+    all.add(two);
+    BOOST_CHECK_EQUAL(all.size(), 4u);
+
+    // the observed value names the resources, the event value does not
+    vle::value::Value* observed = all.toValue();
+    const vle::value::Set& first =
+        vle::value::toSetValue(*vle::value::toSetValue(*observed).get(0));
+
+    BOOST_CHECK_EQUAL(vle::value::toString(first.get(0)), "P1_1");
+    BOOST_CHECK_EQUAL(vle::value::toString(first.get(1)), "P1");
+    BOOST_CHECK_EQUAL(Resources(observed).size(), 4u);
+    delete observed;
+}
+
+BOOST_AUTO_TEST_CASE(test_arena)
+{
+    std::size_t used = Arena::used();
+    Resources* r = new Resources;
+
+    BOOST_CHECK_EQUAL(Arena::used(), used + 1);
+    delete r;
+    BOOST_CHECK_EQUAL(Arena::used(), used);
+
+    Resources* s = new Resources;
+
+    BOOST_CHECK(s == r);
+    delete s;
+    Arena::purge();
+}
+
+BOOST_AUTO_TEST_CASE(test_activity_copy)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    ResourceConstraints resourceConstraints;
+
+    resourceConstraints.push_back(ResourceConstraint("C1", 1, true));
+
+    Activity a("A1", tc);
+
+    a.addStep(new Step("A1_1", 10, Location("L1"), resourceConstraints, tc));
+
+    Resources resources;
+
+    resources.insert(ResourceRegistry::add("C1_1", "C1"));
+    a.wait(0);
+    a.assign(resources);
+
+    Activity b("B1", tc);
+
+    b = a;
+    BOOST_CHECK_EQUAL(b.name(), "A1");
+    BOOST_CHECK_EQUAL(b.allocatedResources().size(), 1u);
+    BOOST_CHECK(b.current() == a.current());
+
+    b.addStep(new Step("A1_2", 5, Location("L2"), resourceConstraints, tc));
+    b.wait(0);
+    BOOST_CHECK(b.current() != a.current());
+    BOOST_CHECK_EQUAL(b.current()->name(), "A1_1");
+}
+
+BOOST_AUTO_TEST_CASE(test_waiting_activities)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    Activity a1("A1", tc);
+    Activity a2("A2", tc);
+    Activity a3("A3", tc);
+    WaitingActivities waiting;
+
+    waiting.push(&a1, 2);
+    waiting.push(&a2, 1);
+    waiting.push(&a3, 2);
+    BOOST_CHECK_EQUAL(waiting.front(), &a2);
+
+    WaitingActivities::const_iterator it = waiting.find(&a3);
+
+    waiting.erase(&a2);
+    waiting.reprioritize(&a1, 3);
+    BOOST_CHECK_EQUAL(*it, &a3);
+    BOOST_CHECK_EQUAL(waiting.front(), &a3);
+    ++it;
+    BOOST_CHECK_EQUAL(*it, &a1);
+    BOOST_CHECK_EQUAL(waiting.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(test_policies)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    ResourceConstraints resourceConstraints;
+    Activity a1("A1", tc);
+    Activity a2("A2", tc);
+
+    a1.addStep(new Step("A1_1", 10, Location("L1"), resourceConstraints, tc));
+    a2.addStep(new Step("A2_1", 5, Location("L1"), resourceConstraints, tc));
+    a2.addStep(new Step("A2_2", 20, Location("L1"), resourceConstraints, tc));
+    a1.wait(0);
+    a2.wait(0);
+    BOOST_CHECK_EQUAL(a2.remainingSteps(), 1u);
+    BOOST_CHECK_EQUAL(a2.remainingWork(), 25);
+
+    WaitingActivities fifo;
+    WaitingActivities spt;
+    WaitingActivities grpw;
+    StepSchedulingPolicy* policies[3] = { buildPolicy("FIFO", fifo),
+                                          buildPolicy("SPT", spt),
+                                          buildPolicy("GRPW", grpw) };
+
+    for (unsigned int i = 0; i < 3; ++i) {
+        policies[i]->add(&a1);
+        policies[i]->add(&a2);
+    }
+    BOOST_CHECK_EQUAL(policies[0]->select(), &a1);
+    BOOST_CHECK_EQUAL(policies[1]->select(), &a2);
+    BOOST_CHECK_EQUAL(policies[2]->select(), &a2);
+    BOOST_CHECK(buildPolicy("unknown", fifo) == 0);
+    for (unsigned int i = 0; i < 3; ++i) {
+        delete policies[i];
+    }
+
+    WaitingActivities runtime;
+    StepSchedulingPolicy* policy = new RuntimePolicy(runtime);
+    vle::value::Map events;
+
+    events.add("policy", new vle::value::String("SPT"));
+    policy->configure(events);
+    policy->add(&a1);
+    policy->add(&a2);
+    BOOST_CHECK_EQUAL(policy->select(), &a2);
+    delete policy;
+}
+
+BOOST_AUTO_TEST_CASE(test_policy_priorities)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    TemporalConstraints lf30(TemporalConstraints::LF,
+                             vle::devs::negativeInfinity, vle::devs::infinity,
+                             vle::devs::negativeInfinity, 30);
+    TemporalConstraints lf40(TemporalConstraints::LF,
+                             vle::devs::negativeInfinity, vle::devs::infinity,
+                             vle::devs::negativeInfinity, 40);
+    TemporalConstraints lf12(TemporalConstraints::LF,
+                             vle::devs::negativeInfinity, vle::devs::infinity,
+                             vle::devs::negativeInfinity, 12);
+    ResourceConstraints resourceConstraints;
+    Activity a1("A1", lf30);
+    Activity a2("A2", lf40);
+    Activity a3("A3", tc);
+
+    // A1: one step of 10, slack 20; A2: steps of 5 (due at 12) and 20,
+    // slack 15; A3: one step of 8, no late finish time, followed by two
+    // activities of 15 in all
+    a1.addStep(new Step("A1_1", 10, Location("L1"), resourceConstraints, tc));
+    a2.addStep(new Step("A2_1", 5, Location("L1"), resourceConstraints,
+                        lf12));
+    a2.addStep(new Step("A2_2", 20, Location("L1"), resourceConstraints, tc));
+    a3.addStep(new Step("A3_1", 8, Location("L1"), resourceConstraints, tc));
+    a1.wait(0);
+    a2.wait(0);
+    a3.wait(0);
+    a3.successors(2, 15);
+
+    const char* names[8] = { "FIFO", "SPT", "LFT", "MTS", "GRPW",
+                             "MinSlack", "EDD", "Backfilling" };
+    Activity* orders[8][3] = { { &a1, &a2, &a3 },
+                               { &a2, &a3, &a1 },
+                               { &a2, &a1, &a3 },
+                               { &a3, &a1, &a2 },
+                               { &a2, &a3, &a1 },
+                               { &a2, &a1, &a3 },
+                               { &a1, &a2, &a3 },
+                               { &a1, &a2, &a3 } };
+
+    for (unsigned int i = 0; i < 8; ++i) {
+        WaitingActivities waiting;
+        StepSchedulingPolicy* policy = buildPolicy(names[i], waiting);
+
+        BOOST_REQUIRE(policy != 0);
+        policy->add(&a1);
+        policy->add(&a2);
+        policy->add(&a3);
+        BOOST_CHECK_MESSAGE(policy->select() == orders[i][0], names[i]);
+        for (unsigned int j = 1; j < 3; ++j) {
+            BOOST_REQUIRE(policy->next());
+            BOOST_CHECK_MESSAGE(policy->select() == orders[i][j], names[i]);
+        }
+        BOOST_CHECK(not policy->next());
+        if (i == 2 or i == 5 or i == 6) {
+            BOOST_CHECK_EQUAL(policy->priority(&a3), vle::devs::infinity);
+        }
+        delete policy;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_backfilling)
+{
+    TemporalConstraints tc(TemporalConstraints::NONE,
+                           vle::devs::negativeInfinity, vle::devs::infinity,
+                           vle::devs::negativeInfinity, vle::devs::infinity);
+    ResourceConstraints big;
+    ResourceConstraints small;
+
+    big.push_back(ResourceConstraint("B1", 2, false));
+    small.push_back(ResourceConstraint("B1", 1, false));
+
+    Activity running("R", tc);
+    Activity head("H", tc);
+    Activity shortStep("S", tc);
+    Activity longStep("L", tc);
+
+    running.addStep(new Step("R_1", 10, Location("L1"), small, tc));
+    head.addStep(new Step("H_1", 5, Location("L1"), big, tc));
+    shortStep.addStep(new Step("S_1", 4, Location("L1"), small, tc));
+    longStep.addStep(new Step("L_1", 20, Location("L1"), small, tc));
+    running.wait(0);
+    head.wait(0);
+    shortStep.wait(0);
+    longStep.wait(0);
+
+    Resources resources;
+
+    resources.insert(ResourceRegistry::add("B1_1", "B1"));
+    running.assign(resources);
+
+    WaitingActivities waiting;
+    BackfillingPolicy policy(waiting);
+    ResourceTypes missing;
+
+    missing[Symbols::resourceTypes().id("B1")] = 1;
+    policy.started(&running, 0);
+    policy.add(&head);
+    policy.add(&longStep);
+    policy.add(&shortStep);
+    policy.unavailable(missing, 2);
+    BOOST_CHECK_EQUAL(policy.reservation(), 10);
+    BOOST_REQUIRE(policy.next());
+    BOOST_CHECK_EQUAL(policy.select(), &shortStep);
+    BOOST_CHECK(not policy.next());
+    // the resources the next step keeps are not released
+    ResourceConstraints kept;
+    Activity keeper("K", tc);
+    WaitingActivities others;
+    BackfillingPolicy reserving(others);
+
+    kept.push_back(ResourceConstraint("B1", 1, true));
+    keeper.addStep(new Step("K_1", 3, Location("L1"), small, tc));
+    keeper.addStep(new Step("K_2", 3, Location("L1"), kept, tc));
+    keeper.attach(0, 1);
+    keeper.wait(0);
+    keeper.assign(resources);
+    BOOST_CHECK(keeper.finishingResources().empty());
+    reserving.started(&keeper, 0);
+    reserving.add(&head);
+    reserving.unavailable(missing, 2);
+    BOOST_CHECK_EQUAL(reserving.reservation(), vle::devs::infinity);
+}
+
+BOOST_AUTO_TEST_CASE(test_run)
+{
+    unsigned int models = Run::models();
+
+    {
+        Run first;
+
+        {
+            Run second;
+
+            ResourceRegistry::add("X_1", "X");
+            BOOST_CHECK_EQUAL(Run::models(), models + 2);
+        }
+        BOOST_CHECK_THROW(ResourceRegistry::add("X_1", "Y"),
+                          vle::utils::ModellingError);
+    }
+
+    // the next run of the thread may bind the name to another type, and
+    // starts with an empty arena
+    BOOST_CHECK_EQUAL(Run::models(), 0u);
+    BOOST_CHECK_EQUAL(Arena::used(), 0u);
+    BOOST_CHECK_EQUAL(ResourceRegistry::size(), 0u);
+    BOOST_CHECK_EQUAL(Symbols::resourceTypes().size(), 0u);
+
+    unsigned int id = ResourceRegistry::add("X_1", "Y");
+
+    BOOST_CHECK_EQUAL(ResourceRegistry::get(id).type(),
+                      Symbols::resourceTypes().id("Y"));
+}